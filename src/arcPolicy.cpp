@@ -0,0 +1,142 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include <algorithm>
+
+#include "arcPolicy.h"
+
+namespace badgerdb {
+
+bool ArcPolicy::GhostList::remove(const std::uint64_t key)
+{
+	std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator>::iterator it = index.find(key);
+	if (it == index.end())
+		return false;
+	keys.erase(it->second);
+	index.erase(it);
+	return true;
+}
+
+void ArcPolicy::GhostList::add(const std::uint64_t key, const std::size_t limit)
+{
+	remove(key);
+	index[key] = keys.insert(keys.end(), key);
+	while (keys.size() > limit)
+		popOldest();
+}
+
+void ArcPolicy::GhostList::popOldest()
+{
+	index.erase(keys.front());
+	keys.pop_front();
+}
+
+ArcPolicy::ArcPolicy(BufDesc *descs, const std::uint32_t bufs)
+	: ReplacementPolicy(descs, bufs),
+		target(0),
+		frameList(bufs, NO_LIST),
+		framePosition(bufs),
+		frameKeys(bufs)
+{
+}
+
+bool ArcPolicy::firstEvictable(std::list<FrameId> &list, FrameId &frame)
+{
+	// hits move frames to the back of T2, so they are applied to the frames
+	// the scan comes across, which then come up again later on
+	for (std::list<FrameId>::iterator it = list.begin(); it != list.end(); ) {
+		const FrameId candidate = *it;
+		++it;
+		if (applyHit(candidate))
+			continue;
+		if (isEvictable(candidate)) {
+			frame = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ArcPolicy::applyHit(const FrameId frame)
+{
+	if (takeHit(frame) == 0)
+		return false;
+	// any repeated reference makes the page frequent
+	if (frameList[frame] == T1_LIST) {
+		t2.splice(t2.end(), t1, framePosition[frame]);
+		frameList[frame] = T2_LIST;
+	}
+	else if (frameList[frame] == T2_LIST) {
+		t2.splice(t2.end(), t2, framePosition[frame]);
+	}
+	return true;
+}
+
+void ArcPolicy::pageLoaded(const FrameId frame, const std::uint64_t pageKey)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	frameKeys[frame] = pageKey;
+	const std::uint32_t b1Size = b1.keys.size();
+	const std::uint32_t b2Size = b2.keys.size();
+	if (b1.remove(pageKey)) {
+		// T1 was too small to keep this page: grow its target
+		target = std::min(numBufs, target + std::max(b2Size / b1Size, 1u));
+		frameList[frame] = T2_LIST;
+		framePosition[frame] = t2.insert(t2.end(), frame);
+		return;
+	}
+	if (b2.remove(pageKey)) {
+		// T2 was too small to keep this page: shrink the target of T1
+		const std::uint32_t delta = std::max(b1Size / b2Size, 1u);
+		target = target > delta ? target - delta : 0;
+		frameList[frame] = T2_LIST;
+		framePosition[frame] = t2.insert(t2.end(), frame);
+		return;
+	}
+
+	// a page not seen recently; keep T1 and B1 together, and the whole
+	// directory, within one and two pools' worth of pages
+	if (t1.size() + b1.keys.size() >= numBufs && !b1.keys.empty())
+		b1.popOldest();
+	else if (t1.size() + t2.size() + b1.keys.size() + b2.keys.size() >= 2 * numBufs && !b2.keys.empty())
+		b2.popOldest();
+	frameList[frame] = T1_LIST;
+	framePosition[frame] = t1.insert(t1.end(), frame);
+}
+
+void ArcPolicy::pagePinned(const FrameId frame)
+{
+	noteHit(frame, 1);
+}
+
+void ArcPolicy::pageRemoved(const FrameId frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	// a page hit since it was last looked at leaves a ghost in B2
+	applyHit(frame);
+	if (frameList[frame] == T1_LIST) {
+		t1.erase(framePosition[frame]);
+		b1.add(frameKeys[frame], numBufs);
+	}
+	else if (frameList[frame] == T2_LIST) {
+		t2.erase(framePosition[frame]);
+		b2.add(frameKeys[frame], numBufs);
+	}
+	frameList[frame] = NO_LIST;
+}
+
+bool ArcPolicy::pickVictim(FrameId &frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	// replace from T1 while it exceeds its target; fall back to the other
+	// list when every page in the preferred one is pinned
+	if (t1.size() > target || t2.empty())
+		return firstEvictable(t1, frame) || firstEvictable(t2, frame);
+	return firstEvictable(t2, frame) || firstEvictable(t1, frame);
+}
+
+}
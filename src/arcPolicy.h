@@ -0,0 +1,141 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "replacementPolicy.h"
+
+namespace badgerdb {
+
+/**
+* @brief Adaptive replacement cache (Megiddo and Modha)
+*
+* Resident pages are split between T1, pages referenced once recently, and
+* T2, pages referenced at least twice.  The keys of pages replaced from each
+* list are remembered in ghost lists B1 and B2.  A miss that finds its page
+* in B1 grows the target size of T1, one found in B2 shrinks it, so the
+* split between recency and frequency adapts to the workload.  Victims come
+* from T1 while it is larger than its target and from T2 otherwise.
+*/
+class ArcPolicy : public ReplacementPolicy
+{
+ private:
+	/**
+   * List holding the page of a frame
+	 */
+  enum ArcList {
+    NO_LIST,
+    T1_LIST,
+    T2_LIST
+  };
+
+	/**
+   * Ghost list of page keys together with the position of each key in it
+	 */
+  struct GhostList {
+    std::list<std::uint64_t> keys;
+    std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator> index;
+
+    /**
+     * Removes the key if present, returning whether it was.
+     */
+    bool remove(const std::uint64_t key);
+
+    /**
+     * Adds the key as most recent, forgetting the oldest keys beyond limit.
+     */
+    void add(const std::uint64_t key, const std::size_t limit);
+
+    /**
+     * Forgets the oldest key.
+     */
+    void popOldest();
+  };
+
+	/**
+   * Protects all members below
+	 */
+  std::mutex latch;
+
+	/**
+   * Target size of T1
+	 */
+  std::uint32_t target;
+
+	/**
+   * Frames holding pages referenced once, least recently used first
+	 */
+  std::list<FrameId> t1;
+
+	/**
+   * Frames holding pages referenced more than once, least recently used first
+	 */
+  std::list<FrameId> t2;
+
+	/**
+   * Keys of pages replaced from T1
+	 */
+  GhostList b1;
+
+	/**
+   * Keys of pages replaced from T2
+	 */
+  GhostList b2;
+
+	/**
+   * List holding the page of each frame
+	 */
+  std::vector<ArcList> frameList;
+
+	/**
+   * Position of each frame in its list
+	 */
+  std::vector<std::list<FrameId>::iterator> framePosition;
+
+	/**
+   * Key of the page held by each frame
+	 */
+  std::vector<std::uint64_t> frameKeys;
+
+	/**
+   * Returns the least recently used frame in the list that holds an unpinned page.
+	 *
+	 * @return  			False if there is none
+	 */
+  bool firstEvictable(std::list<FrameId> &list, FrameId &frame);
+
+	/**
+   * Applies the hit noted on the frame, if any, moving the frame to the back of T2.
+	 *
+	 * @return  			True if there was a hit
+	 */
+  bool applyHit(const FrameId frame);
+
+ public:
+	/**
+   * Constructor of ArcPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  ArcPolicy(BufDesc *descs, const std::uint32_t bufs);
+
+  void pageLoaded(const FrameId frame, const std::uint64_t pageKey);
+
+  void pagePinned(const FrameId frame);
+
+  void pageRemoved(const FrameId frame);
+
+  bool pickVictim(FrameId &frame);
+};
+
+}
@@ -0,0 +1,1104 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "buffer.h"
+#include "bufHashTbl.h"
+#include "flatBufHashTbl.h"
+#include "exceptions/file_not_found_exception.h"
+#include "exceptions/hash_not_found_exception.h"
+
+using namespace badgerdb;
+
+/**
+ * Simple wall clock timer used by all the benchmarks.
+ */
+class Timer
+{
+ public:
+	Timer() : start(std::chrono::steady_clock::now()) {}
+
+	/**
+	 * Returns the number of nanoseconds elapsed since the timer was created.
+	 */
+	double elapsedNs() const
+	{
+		return std::chrono::duration<double, std::nano>(
+				std::chrono::steady_clock::now() - start).count();
+	}
+
+ private:
+	std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Creates a fresh file with the given number of pages, each holding one record.
+ */
+static File createBenchFile(const std::string& filename, const PageId numPages)
+{
+	try
+	{
+		File::remove(filename);
+	}
+	catch (FileNotFoundException&)
+	{
+	}
+
+	File file = File::create(filename);
+	for (PageId i = 0; i < numPages; i++)
+	{
+		Page new_page = file.allocatePage();
+		new_page.insertRecord("benchmark record");
+		file.writePage(new_page);
+	}
+	return file;
+}
+
+static void report(const std::string& name, const double totalNs, const std::uint64_t ops)
+{
+	std::cout << "  " << name << ": " << totalNs / ops << " ns/op (" << ops << " ops)\n";
+}
+
+static void reportThroughput(const std::string& name, const double totalNs, const std::uint64_t ops)
+{
+	std::cout << "  " << name << ": " << ops * 1000.0 / totalNs << " Mops/s (" << ops << " ops)\n";
+}
+
+/**
+ * Compares a hash table miss through the throwing lookup() with the
+ * non-throwing find() used by the buffer manager.
+ */
+static void benchHashMiss()
+{
+	std::cout << "hash table miss latency\n";
+
+	const std::uint32_t entries = 1000;
+	const std::uint64_t probes = 200000;
+	{
+		File file = createBenchFile("bench.db", 1);
+		BufHashTbl table(entries * 2 + 1);
+		for (PageId i = 1; i <= entries; i++)
+			table.insert(&file, i, i);
+
+		FrameId frameNo;
+		std::uint64_t misses = 0;
+		{
+			Timer timer;
+			for (std::uint64_t i = 0; i < probes; i++)
+			{
+				try
+				{
+					table.lookup(&file, entries + 1 + (i % entries), frameNo);
+				}
+				catch (HashNotFoundException&)
+				{
+					misses++;
+				}
+			}
+			report("lookup() miss (exception)", timer.elapsedNs(), probes);
+		}
+		{
+			Timer timer;
+			for (std::uint64_t i = 0; i < probes; i++)
+			{
+				if (!table.find(&file, entries + 1 + (i % entries), frameNo))
+					misses++;
+			}
+			report("find() miss", timer.elapsedNs(), probes);
+		}
+
+		if (misses != probes * 2)
+			std::cout << "  unexpected hits during miss benchmark\n";
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Runs inserts, hits, misses and eviction style churn against one hash table.
+ */
+static void benchTable(const std::string& name, BufHashIndex& table,
+		const std::vector<const File*>& files, const std::uint32_t entries)
+{
+	std::cout << " " << name << "\n";
+
+	// spread the entries over all files, pages of a file being consecutive
+	std::vector<std::pair<const File*, PageId> > keys;
+	for (std::uint32_t i = 0; i < entries; i++)
+		keys.push_back(std::make_pair(files[i % files.size()], (PageId)(i / files.size() + 1)));
+	std::vector<std::uint32_t> order(entries);
+	for (std::uint32_t i = 0; i < entries; i++)
+		order[i] = i;
+	std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+	{
+		Timer timer;
+		for (std::uint32_t i = 0; i < entries; i++)
+			table.insert(keys[i].first, keys[i].second, i);
+		report("insert", timer.elapsedNs(), entries);
+	}
+
+	FrameId frameNo;
+	std::uint64_t found = 0;
+	{
+		Timer timer;
+		for (std::uint32_t i = 0; i < entries; i++)
+			found += table.find(keys[order[i]].first, keys[order[i]].second, frameNo);
+		report("find() hit", timer.elapsedNs(), entries);
+	}
+	{
+		Timer timer;
+		for (std::uint32_t i = 0; i < entries; i++)
+			found += table.find(keys[order[i]].first, keys[order[i]].second + entries, frameNo);
+		report("find() miss", timer.elapsedNs(), entries);
+	}
+	{
+		// evict a page and load a new one in its frame, as allocBuf() does
+		Timer timer;
+		for (std::uint32_t i = 0; i < entries; i++)
+		{
+			const std::pair<const File*, PageId>& key = keys[order[i]];
+			table.remove(key.first, key.second);
+			table.insert(key.first, key.second + entries, order[i]);
+		}
+		report("remove+insert churn", timer.elapsedNs(), entries);
+	}
+
+	if (found != entries)
+		std::cout << "  unexpected number of hits: " << found << "\n";
+}
+
+/**
+ * Compares the chained and the open addressing hash tables.
+ */
+static void benchHashTables()
+{
+	std::cout << "hash table comparison\n";
+
+	const std::uint32_t entries = 1 << 16;
+	{
+		File file = createBenchFile("bench.db", 1);
+		// distinct File objects for the same file, as different callers would have
+		std::vector<File> copies(4, file);
+		std::vector<const File*> files;
+		for (std::size_t i = 0; i < copies.size(); i++)
+			files.push_back(&copies[i]);
+
+		{
+			BufHashTbl chained(((int)(entries * 1.2)) + 1);
+			benchTable("BufHashTbl (chained)", chained, files, entries);
+		}
+		{
+			FlatBufHashTbl flat(entries * 2);
+			benchTable("FlatBufHashTbl (open addressing)", flat, files, entries);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Prints a summary of a comparison count histogram as reported by
+ * BufHashIndex::probeHistogram().
+ */
+static void reportHistogram(const std::string& name, const std::vector<std::uint32_t>& histogram)
+{
+	std::uint64_t entries = 0, comparisons = 0;
+	for (std::size_t i = 0; i < histogram.size(); i++)
+	{
+		entries += histogram[i];
+		comparisons += (std::uint64_t)histogram[i] * (i + 1);
+	}
+	std::cout << "  " << name << ": mean " << (double)comparisons / entries
+			  << " comparisons, max " << histogram.size() << ", histogram";
+	for (std::size_t i = 0; i < histogram.size() && i < 8; i++)
+		std::cout << " " << histogram[i];
+	if (histogram.size() > 8)
+		std::cout << " ...";
+	std::cout << "\n";
+}
+
+/**
+ * Reports how evenly the buffer pool hash tables spread consecutive pages of a
+ * few files, next to the address based hash the chained table used to have.
+ */
+static void benchHashDistribution()
+{
+	std::cout << "hash table collision distribution\n";
+
+	const std::uint32_t bufs = 1 << 14;
+	{
+		File file = createBenchFile("bench.db", 1);
+		std::vector<File> copies(4, file);
+		std::vector<std::pair<const File*, PageId> > keys;
+		for (std::uint32_t i = 0; i < bufs; i++)
+			keys.push_back(std::make_pair(&copies[i % copies.size()], (PageId)(i / copies.size() + 1)));
+
+		// the old hash: (address + pageNo) modulo the old table size
+		const std::uint32_t legacySize = ((std::uint32_t)(bufs * 1.2)) + 1;
+		std::vector<std::uint32_t> chainLength(legacySize, 0), legacy;
+		for (std::size_t i = 0; i < keys.size(); i++)
+		{
+			std::uint32_t bucket = ((std::uint32_t)(std::uintptr_t)keys[i].first + keys[i].second) % legacySize;
+			std::uint32_t depth = chainLength[bucket]++;
+			if (legacy.size() <= depth)
+				legacy.resize(depth + 1, 0);
+			legacy[depth]++;
+		}
+		reportHistogram("address hash, chained", legacy);
+
+		BufHashTbl chained(legacySize);
+		FlatBufHashTbl flat(bufs * 2);
+		for (std::size_t i = 0; i < keys.size(); i++)
+		{
+			chained.insert(keys[i].first, keys[i].second, i);
+			flat.insert(keys[i].first, keys[i].second, i);
+		}
+		std::vector<std::uint32_t> histogram;
+		chained.probeHistogram(histogram);
+		reportHistogram("mixing hash, chained", histogram);
+		flat.probeHistogram(histogram);
+		reportHistogram("mixing hash, open addressing", histogram);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Scans a file larger than the buffer pool so that every readPage() misses.
+ */
+static void benchScanMiss()
+{
+	std::cout << "readPage() scan miss latency\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t numFrames = 64;
+	const HashTableType types[] = {CHAINED_HASH_TABLE, FLAT_HASH_TABLE};
+	const char* names[] = {"readPage() miss, chained table", "readPage() miss, flat table"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int t = 0; t < 2; t++)
+		{
+			BufMgr bufMgr(numFrames, types[t]);
+			Page* page;
+
+			Timer timer;
+			for (PageId i = 1; i <= numPages; i++)
+			{
+				bufMgr.readPage(&file, i, page);
+				bufMgr.unPinPage(&file, i, false);
+			}
+			report(names[t], timer.elapsedNs(), numPages);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Reads pages into mostly empty buffer pools of growing size, so that the
+ * cost of finding a frame for each miss shows up against the pool size.
+ */
+static void benchColdMiss()
+{
+	std::cout << "readPage() miss latency into an empty pool\n";
+
+	const PageId numPages = 1024;
+	const std::uint32_t poolSizes[] = {1024, 4096, 16384};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int p = 0; p < 3; p++)
+		{
+			BufMgr bufMgr(poolSizes[p]);
+			Page* page;
+
+			Timer timer;
+			for (PageId i = 1; i <= numPages; i++)
+			{
+				bufMgr.readPage(&file, i, page);
+				bufMgr.unPinPage(&file, i, false);
+			}
+			report("pool of " + std::to_string(poolSizes[p]) + " frames", timer.elapsedNs(), numPages);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Flushes a file with only a few pages resident in a large buffer pool, so
+ * the cost of finding the file's frames shows up against the pool size.
+ */
+static void benchFlushFile()
+{
+	std::cout << "flushFile() latency with 64 resident pages\n";
+
+	const PageId numPages = 64;
+	const int rounds = 200;
+	const std::uint32_t poolSizes[] = {1024, 16384};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int p = 0; p < 2; p++)
+		{
+			BufMgr bufMgr(poolSizes[p]);
+			Page* page;
+			double flushNs = 0;
+			for (int r = 0; r < rounds; r++)
+			{
+				for (PageId i = 1; i <= numPages; i++)
+				{
+					bufMgr.readPage(&file, i, page);
+					bufMgr.unPinPage(&file, i, false);
+				}
+				Timer timer;
+				bufMgr.flushFile(&file);
+				flushNs += timer.elapsedNs();
+			}
+			report("pool of " + std::to_string(poolSizes[p]) + " frames", flushNs, rounds);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Reads and writes random pages of a file in the page cache directly through
+ * File, which measures the cost of the I/O path itself.
+ */
+static void benchFileIO()
+{
+	std::cout << "File page I/O on a cached file\n";
+
+	const PageId numPages = 1024;
+	const std::uint64_t ops = 1 << 16;
+	{
+		File file = createBenchFile("bench.db", numPages);
+		std::mt19937 rng(7);
+		Timer readTimer;
+		for (std::uint64_t i = 0; i < ops; i++)
+			file.readPage(rng() % numPages + 1);
+		report("readPage()", readTimer.elapsedNs(), ops);
+
+		Page page = file.readPage(1);
+		Timer writeTimer;
+		for (std::uint64_t i = 0; i < ops; i++)
+			file.writePage(page);
+		report("writePage()", writeTimer.elapsedNs(), ops);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Scans a file eight times the size of the buffer pool, dirtying every page,
+ * so that each miss first writes back a dirty victim.
+ */
+static void benchDirtyMiss()
+{
+	std::cout << "readPage() miss replacing a dirty page\n";
+
+	const PageId numPages = 4096;
+	const std::uint32_t poolSize = numPages / 8;
+	const int passes = 4;
+	{
+		File file = createBenchFile("bench.db", numPages);
+		BufMgr bufMgr(poolSize);
+		Page* page;
+		Timer timer;
+		for (int p = 0; p < passes; p++)
+		{
+			for (PageId i = 1; i <= numPages; i++)
+			{
+				bufMgr.readPage(&file, i, page);
+				bufMgr.unPinPage(&file, i, true);
+			}
+		}
+		reportThroughput("dirty misses", timer.elapsedNs(), (std::uint64_t)passes * numPages);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Grows a file one allocatePage() at a time, timing the allocations made
+ * once the file is large, then deletes pages all over the file and
+ * allocates them again.
+ */
+static void benchAllocate()
+{
+	std::cout << "File::allocatePage() and deletePage() in a large file\n";
+
+	const PageId numPages = 2048;
+	const PageId timedPages = 512;
+	try
+	{
+		File::remove("bench.db");
+	}
+	catch (FileNotFoundException&)
+	{
+	}
+	{
+		File file = File::create("bench.db");
+		for (PageId i = 0; i < numPages - timedPages; i++)
+			file.allocatePage();
+		Timer appendTimer;
+		for (PageId i = 0; i < timedPages; i++)
+			file.allocatePage();
+		report("append to " + std::to_string(numPages - timedPages) + "+ pages", appendTimer.elapsedNs(), timedPages);
+
+		Timer deleteTimer;
+		for (PageId i = 1; i <= timedPages; i++)
+			file.deletePage(i * (numPages / timedPages));
+		report("delete a page", deleteTimer.elapsedNs(), timedPages);
+		Timer reuseTimer;
+		for (PageId i = 0; i < timedPages; i++)
+			file.allocatePage();
+		report("reuse a free page", reuseTimer.elapsedNs(), timedPages);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Opens a large file, which loads its page directory, and counts its used
+ * pages.
+ */
+static void benchOpen()
+{
+	std::cout << "File::open() of a large file\n";
+
+	const PageId numPages = 8192;
+	const int opens = 20;
+	createBenchFile("bench.db", numPages);
+	Timer openTimer;
+	PageId usedPages = 0;
+	for (int i = 0; i < opens; i++)
+	{
+		File file = File::open("bench.db");
+		usedPages += file.numUsedPages();
+	}
+	report("open " + std::to_string(numPages) + " pages", openTimer.elapsedNs(), opens);
+	if (usedPages != numPages * opens)
+		std::cout << "  unexpected used page count " << usedPages << "\n";
+	File::remove("bench.db");
+}
+
+/**
+ * Bulk loads a new file through BufMgr::allocPage(), growing it one page at a
+ * time and a preallocated extent at a time, and reports the load bandwidth.
+ */
+static void benchBulkLoad()
+{
+	std::cout << "bulk load through BufMgr::allocPage()\n";
+
+	const PageId numPages = 8192;
+	const PageId extents[] = {1, File::DEFAULT_EXTENT_PAGES, 1024};
+	for (int e = 0; e < 3; e++)
+	{
+		try
+		{
+			File::remove("bench.db");
+		}
+		catch (FileNotFoundException&)
+		{
+		}
+		File file = File::create("bench.db");
+		file.setExtentPages(extents[e]);
+		Timer timer;
+		{
+			BufMgr bufMgr(256);
+			PageId pageNo;
+			Page* page;
+			for (PageId i = 0; i < numPages; i++)
+			{
+				bufMgr.allocPage(&file, pageNo, page);
+				page->insertRecord("benchmark record");
+				bufMgr.unPinPage(&file, pageNo, true);
+			}
+			bufMgr.flushFile(&file);
+		}
+		const double elapsed = timer.elapsedNs();
+		std::cout << "  extent of " << extents[e] << " pages: " << elapsed / numPages << " ns/page, "
+				<< numPages * double(Page::SIZE) * 1000.0 / elapsed << " MB/s\n";
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Writes back pages dirtied in random order, one writePage() per page in the
+ * order they were dirtied as flushFile() used to, and through flushFile(),
+ * which sorts them and writes runs of adjacent pages together.
+ */
+static void benchWriteBack()
+{
+	std::cout << "writing back 1024 pages dirtied in random order\n";
+
+	const PageId numPages = 1024;
+	const int rounds = 20;
+	{
+		File file = createBenchFile("bench.db", numPages);
+		std::vector<PageId> order;
+		for (PageId i = 1; i <= numPages; i++)
+			order.push_back(i);
+		std::mt19937 rng(7);
+
+		std::vector<Page> pages;
+		for (PageId i = 1; i <= numPages; i++)
+			pages.push_back(file.readPage(i));
+		double perPageNs = 0;
+		for (int r = 0; r < rounds; r++)
+		{
+			std::shuffle(order.begin(), order.end(), rng);
+			Timer timer;
+			for (PageId i = 0; i < numPages; i++)
+				file.writePage(pages[order[i] - 1]);
+			perPageNs += timer.elapsedNs();
+		}
+		report("writePage() per page", perPageNs, (std::uint64_t)rounds * numPages);
+
+		BufMgr bufMgr(numPages);
+		Page* page;
+		double flushNs = 0;
+		for (int r = 0; r < rounds; r++)
+		{
+			std::shuffle(order.begin(), order.end(), rng);
+			for (PageId i = 0; i < numPages; i++)
+			{
+				bufMgr.readPage(&file, order[i], page);
+				bufMgr.unPinPage(&file, order[i], true);
+			}
+			Timer timer;
+			bufMgr.flushFile(&file);
+			flushNs += timer.elapsedNs();
+		}
+		report("flushFile(), sorted and coalesced", flushNs, (std::uint64_t)rounds * numPages);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Rereads pages that all fit in the buffer pool so that every readPage() hits.
+ */
+static void benchHit()
+{
+	std::cout << "readPage() hit latency\n";
+
+	const PageId numPages = 1024;
+	const std::uint64_t reads = 1 << 20;
+	const HashTableType types[] = {CHAINED_HASH_TABLE, FLAT_HASH_TABLE};
+	const char* names[] = {"readPage() hit, chained table", "readPage() hit, flat table"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int t = 0; t < 2; t++)
+		{
+			BufMgr bufMgr(numPages, types[t]);
+			Page* page;
+			for (PageId i = 1; i <= numPages; i++)
+			{
+				bufMgr.readPage(&file, i, page);
+				bufMgr.unPinPage(&file, i, false);
+			}
+
+			std::mt19937 rng(7);
+			Timer timer;
+			for (std::uint64_t i = 0; i < reads; i++)
+			{
+				const PageId pageNo = rng() % numPages + 1;
+				bufMgr.readPage(&file, pageNo, page);
+				bufMgr.unPinPage(&file, pageNo, false);
+			}
+			report(names[t], timer.elapsedNs(), reads);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Compares readPage()/unPinPage() hits with fetchPage() guards, which unpin
+ * through the frame they hold instead of a second hash lookup.
+ */
+static void benchGuard()
+{
+	std::cout << "pinned page access latency\n";
+
+	const PageId numPages = 1024;
+	const std::uint64_t reads = 1 << 20;
+	{
+		File file = createBenchFile("bench.db", numPages);
+		BufMgr bufMgr(numPages, FLAT_HASH_TABLE);
+		Page* page;
+		for (PageId i = 1; i <= numPages; i++)
+		{
+			bufMgr.readPage(&file, i, page);
+			bufMgr.unPinPage(&file, i, false);
+		}
+
+		std::mt19937 rng(7);
+		Timer lookupTimer;
+		for (std::uint64_t i = 0; i < reads; i++)
+		{
+			const PageId pageNo = rng() % numPages + 1;
+			bufMgr.readPage(&file, pageNo, page);
+			bufMgr.unPinPage(&file, pageNo, false);
+		}
+		report("readPage() + unPinPage()", lookupTimer.elapsedNs(), reads);
+
+		rng.seed(7);
+		Timer guardTimer;
+		for (std::uint64_t i = 0; i < reads; i++)
+		{
+			PageGuard guard = bufMgr.fetchPage(&file, rng() % numPages + 1);
+		}
+		report("fetchPage() guard", guardTimer.elapsedNs(), reads);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Reads random pages from many threads at once and reports the combined
+ * throughput, with one hash table shard and with one shard per thread.
+ * The file is twice the pool size, so about half of the reads miss.
+ */
+static void benchThreads()
+{
+	std::cout << "readPage() throughput by thread count\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = 1024;
+	const std::uint64_t readsPerThread = 1 << 15;
+	const std::uint32_t shardCounts[] = {1, 64};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int s = 0; s < 2; s++)
+		{
+			for (int threads = 1; threads <= 64; threads *= 2)
+			{
+				BufMgr bufMgr(poolSize, FLAT_HASH_TABLE, shardCounts[s]);
+				std::vector<std::thread> workers;
+
+				Timer timer;
+				for (int t = 0; t < threads; t++)
+				{
+					workers.push_back(std::thread([&bufMgr, &file, t, numPages, readsPerThread]() {
+						std::mt19937 rng(t);
+						Page* page;
+						for (std::uint64_t i = 0; i < readsPerThread; i++)
+						{
+							const PageId pageNo = rng() % numPages + 1;
+							bufMgr.readPage(&file, pageNo, page);
+							bufMgr.unPinPage(&file, pageNo, false);
+						}
+					}));
+				}
+				for (int t = 0; t < threads; t++)
+					workers[t].join();
+				reportThroughput(std::to_string(threads) + " threads, " + std::to_string(shardCounts[s]) + " shards",
+						timer.elapsedNs(), readsPerThread * threads);
+			}
+		}
+
+		// every read hits, so only the hit path of each policy is timed
+		const ReplacementPolicyType policies[] = {CLOCK_POLICY, LRU_K_POLICY, TWO_Q_POLICY, ARC_POLICY, CLOCK_PRO_POLICY};
+		const char* names[] = {"clock", "LRU-2", "2Q", "ARC", "CLOCK-Pro"};
+		const int hitThreads = 8;
+		for (int p = 0; p < 5; p++)
+		{
+			BufMgr bufMgr(2 * numPages, FLAT_HASH_TABLE, 64, policies[p]);
+			bufMgr.adviseAccess(&file, ACCESS_RANDOM);
+			Page* page;
+			for (PageId pageNo = 1; pageNo <= numPages; pageNo++)
+			{
+				bufMgr.readPage(&file, pageNo, page);
+				bufMgr.unPinPage(&file, pageNo, false);
+			}
+			std::vector<std::thread> workers;
+			Timer timer;
+			for (int t = 0; t < hitThreads; t++)
+			{
+				workers.push_back(std::thread([&bufMgr, &file, t, numPages, readsPerThread]() {
+					std::mt19937 rng(t);
+					Page* page;
+					for (std::uint64_t i = 0; i < readsPerThread; i++)
+					{
+						const PageId pageNo = rng() % numPages + 1;
+						bufMgr.readPage(&file, pageNo, page);
+						bufMgr.unPinPage(&file, pageNo, false);
+					}
+				}));
+			}
+			for (int t = 0; t < hitThreads; t++)
+				workers[t].join();
+			reportThroughput(std::to_string(hitThreads) + " threads, hits only, " + names[p],
+					timer.elapsedNs(), readsPerThread * hitThreads);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Reads one hot page from many threads at once, latching it exclusively,
+ * latching it shared, or reading it optimistically while it stays pinned.
+ */
+static void benchLatchModes()
+{
+	std::cout << "hot page read throughput by latch mode\n";
+
+	const std::uint64_t readsPerThread = 1 << 18;
+	const char* modeNames[] = {"exclusive", "shared", "optimistic"};
+	{
+		File file = createBenchFile("bench.db", 1);
+		BufMgr bufMgr(16, FLAT_HASH_TABLE);
+		Page* hot;
+		bufMgr.readPage(&file, 1, hot);
+		std::atomic<std::size_t> checksum(0);
+		for (int m = 0; m < 3; m++)
+		{
+			for (int threads = 1; threads <= 64; threads *= 4)
+			{
+				std::vector<std::thread> workers;
+				Timer timer;
+				for (int t = 0; t < threads; t++)
+				{
+					workers.push_back(std::thread([&bufMgr, &file, &checksum, hot, m, readsPerThread]() {
+						Page* page;
+						std::size_t length = 0;
+						for (std::uint64_t i = 0; i < readsPerThread; i++)
+						{
+							if (m == 2)
+							{
+								std::uint32_t version;
+								do
+								{
+									version = bufMgr.beginOptimisticRead(hot);
+									length += hot->getFreeSpace();
+								} while (!bufMgr.validateOptimisticRead(hot, version));
+							}
+							else
+							{
+								const LatchMode mode = m == 0 ? LATCH_EXCLUSIVE : LATCH_SHARED;
+								bufMgr.readPage(&file, 1, page, mode);
+								length += page->getFreeSpace();
+								bufMgr.unPinPage(&file, 1, false, mode);
+							}
+						}
+						// keep the reads from being optimized away
+						checksum += length;
+					}));
+				}
+				for (int t = 0; t < threads; t++)
+					workers[t].join();
+				reportThroughput(std::string(modeNames[m]) + ", " + std::to_string(threads) + " threads",
+						timer.elapsedNs(), readsPerThread * threads);
+			}
+		}
+		bufMgr.unPinPage(&file, 1, false);
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Page reference strings the replacement policies are compared on.
+ */
+enum PolicyWorkload {
+	HOT_SET_WITH_SCANS,
+	SKEWED,
+	LOOP
+};
+
+/**
+ * Returns the next page of a reference string over pages 1..numPages.
+ */
+static PageId nextReference(const PolicyWorkload workload, const PageId numPages,
+		std::mt19937& rng, std::uint64_t i)
+{
+	switch (workload) {
+	case HOT_SET_WITH_SCANS:
+		// a hot sixteenth of the file, half the pool, with a 1024 page scan every 4096 references
+		if (i % 4096 < 1024)
+			return numPages / 16 + 1 + (i / 4096 * 1024 + i % 4096) % (numPages / 2);
+		return rng() % (numPages / 16) + 1;
+	case SKEWED:
+		{
+			// probability falls off with the page number, about 80/20
+			const double u = std::generate_canonical<double, 32>(rng);
+			return (PageId)(u * u * u * numPages) + 1;
+		}
+	default:
+		// a loop over a fifth more pages than the pool holds
+		return i % (numPages / 8 * 5 / 4) + 1;
+	}
+}
+
+/**
+ * Reports the hit ratio of every replacement policy on a few reference strings.
+ */
+static void benchPolicies()
+{
+	std::cout << "replacement policy hit ratio, pool of 1/8 of the file\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = numPages / 8;
+	const std::uint64_t references = 1 << 18;
+	const ReplacementPolicyType policies[] = {CLOCK_POLICY, LRU_K_POLICY, TWO_Q_POLICY, ARC_POLICY, CLOCK_PRO_POLICY};
+	const char* policyNames[] = {"clock", "LRU-2", "2Q", "ARC", "CLOCK-Pro"};
+	const PolicyWorkload workloads[] = {HOT_SET_WITH_SCANS, SKEWED, LOOP};
+	const char* workloadNames[] = {"hot set with scans", "skewed", "loop"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int w = 0; w < 3; w++)
+		{
+			for (int p = 0; p < 5; p++)
+			{
+				BufMgr bufMgr(poolSize, FLAT_HASH_TABLE, 1, policies[p]);
+				std::mt19937 rng(7);
+				Page* page;
+				Timer timer;
+				for (std::uint64_t i = 0; i < references; i++)
+				{
+					const PageId pageNo = nextReference(workloads[w], numPages, rng, i);
+					bufMgr.readPage(&file, pageNo, page);
+					bufMgr.unPinPage(&file, pageNo, false);
+				}
+				const double elapsed = timer.elapsedNs();
+				// only reads of the page asked for are misses; a page read ahead and then found is a hit
+				const BufStats& stats = bufMgr.getBufStats();
+				const int misses = stats.diskreads - stats.prefetched;
+				std::cout << "  " << workloadNames[w] << ", " << policyNames[p] << ": "
+						<< 100.0 * (stats.accesses - misses) / stats.accesses << "% hits, "
+						<< elapsed / references << " ns/op\n";
+			}
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Scans a file larger than the buffer pool with and without read-ahead.
+ */
+static void benchReadAhead()
+{
+	std::cout << "readPage() scan with read-ahead, pool of 1/8 of the file\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = numPages / 8;
+	const AccessPattern patterns[] = {ACCESS_RANDOM, ACCESS_NORMAL, ACCESS_SEQUENTIAL};
+	const char* names[] = {"no read-ahead", "detected", "advised sequential"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int p = 0; p < 3; p++)
+		{
+			BufMgr bufMgr(poolSize);
+			bufMgr.adviseAccess(&file, patterns[p]);
+			Page* page;
+
+			Timer timer;
+			for (PageId i = 1; i <= numPages; i++)
+			{
+				bufMgr.readPage(&file, i, page);
+				bufMgr.unPinPage(&file, i, false);
+			}
+			const double elapsed = timer.elapsedNs();
+			const BufStats& stats = bufMgr.getBufStats();
+			std::cout << "  " << names[p] << ": " << elapsed / numPages << " ns/page, "
+					<< stats.prefetched << " read ahead, " << stats.prefetchHits << " used, "
+					<< stats.prefetchWasted << " wasted\n";
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Reads batches of pages scattered over part of the file, as an index probe
+ * would, one readPage() at a time and with one readPages() call.
+ */
+static void benchBatchRead()
+{
+	std::cout << "reading a batch of 64 pages out of 256, cold\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = 256;
+	const int batches = 32;
+	const char* names[] = {"readPage() per page", "readPages()"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int b = 0; b < 2; b++)
+		{
+			BufMgr bufMgr(poolSize);
+			std::mt19937 rng(7);
+			std::vector<Page*> pages;
+			Page* page;
+			double elapsed = 0;
+			for (int n = 0; n < batches; n++)
+			{
+				const PageId base = rng() % (numPages - 256) + 1;
+				std::vector<PageId> pageNos;
+				for (PageId i = 0; i < 256; i++)
+				{
+					if (rng() % 4 == 0)
+						pageNos.push_back(base + i);
+				}
+				std::shuffle(pageNos.begin(), pageNos.end(), rng);
+
+				Timer timer;
+				if (b == 0)
+				{
+					for (std::size_t k = 0; k < pageNos.size(); k++)
+						bufMgr.readPage(&file, pageNos[k], page);
+				}
+				else
+					bufMgr.readPages(&file, pageNos, pages);
+				elapsed += timer.elapsedNs();
+
+				for (std::size_t k = 0; k < pageNos.size(); k++)
+					bufMgr.unPinPage(&file, pageNos[k], false);
+				bufMgr.evictFile(&file);
+			}
+			report(names[b], elapsed, bufMgr.getBufStats().accesses);
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Updates random pages of a file larger than the buffer pool, so that most
+ * misses replace a dirty page, with and without the background writer.
+ */
+static void benchBgWriter()
+{
+	std::cout << "random page updates, pool of 1/8 of the file\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = numPages / 8;
+	const std::uint64_t updates = 1 << 15;
+	const char* names[] = {"without background writer", "with background writer"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int w = 0; w < 2; w++)
+		{
+			BufMgr bufMgr(poolSize);
+			if (w == 1)
+				bufMgr.startBgWriter(BgWriterConfig(poolSize / 4, 100, 1));
+			std::mt19937 rng(7);
+			Page* page;
+
+			Timer timer;
+			for (std::uint64_t i = 0; i < updates; i++)
+			{
+				const PageId pageNo = rng() % numPages + 1;
+				bufMgr.readPage(&file, pageNo, page);
+				bufMgr.unPinPage(&file, pageNo, true);
+			}
+			const double elapsed = timer.elapsedNs();
+			bufMgr.stopBgWriter();
+			const BufStats& stats = bufMgr.getBufStats();
+			std::cout << "  " << names[w] << ": " << elapsed / updates << " ns/op, "
+					<< stats.fgwrites << " written by misses, " << stats.bgwrites << " in the background\n";
+		}
+	}
+	File::remove("bench.db");
+}
+
+/**
+ * Interleaves reads of a hot set, half the pool, with scans of the whole file
+ * and reports how many hot reads hit, with and without a ring for the scans.
+ */
+static void benchRingScan()
+{
+	std::cout << "hot set hit ratio under full scans, pool of 1/8 of the file\n";
+
+	const PageId numPages = 2048;
+	const std::uint32_t poolSize = numPages / 8;
+	const PageId hotPages = poolSize / 2;
+	const int scans = 8;
+	const char* names[] = {"scan without a ring", "scan with a 32 frame ring"};
+	{
+		File file = createBenchFile("bench.db", numPages);
+		for (int r = 0; r < 2; r++)
+		{
+			BufMgr bufMgr(poolSize);
+			BufAccessStrategy strategy(BufAccessStrategy::BULK_READ_RING);
+			Page* page;
+			std::uint64_t hotReads = 0;
+			std::uint64_t hotMisses = 0;
+			Timer timer;
+			for (int s = 0; s < scans; s++)
+			{
+				for (PageId i = 1; i <= numPages; i++)
+				{
+					bufMgr.readPage(&file, i, page, LATCH_NONE, r == 1 ? &strategy : NULL);
+					bufMgr.unPinPage(&file, i, false);
+
+					// a hot read after every eight pages scanned
+					if (i % 8 == 0)
+					{
+						const PageId hot = numPages - hotPages + 1 + (i / 8) % hotPages;
+						const int readsBefore = bufMgr.getBufStats().diskreads;
+						bufMgr.readPage(&file, hot, page);
+						bufMgr.unPinPage(&file, hot, false);
+						hotReads++;
+						hotMisses += bufMgr.getBufStats().diskreads - readsBefore;
+					}
+				}
+			}
+			const double elapsed = timer.elapsedNs();
+			std::cout << "  " << names[r] << ": "
+					<< 100.0 * (hotReads - hotMisses) / hotReads << "% hot hits, "
+					<< elapsed / (scans * numPages) << " ns/page scanned\n";
+		}
+	}
+	File::remove("bench.db");
+}
+
+int main(int argc, char* argv[])
+{
+	// Run every benchmark unless a single one is named on the command line.
+	const std::string only = argc > 1 ? argv[1] : "";
+
+	if (only.empty() || only == "hashmiss")
+		benchHashMiss();
+	if (only.empty() || only == "hashtables")
+		benchHashTables();
+	if (only.empty() || only == "distribution")
+		benchHashDistribution();
+	if (only.empty() || only == "scanmiss")
+		benchScanMiss();
+	if (only.empty() || only == "coldmiss")
+		benchColdMiss();
+	if (only.empty() || only == "flush")
+		benchFlushFile();
+	if (only.empty() || only == "writeback")
+		benchWriteBack();
+	if (only.empty() || only == "fileio")
+		benchFileIO();
+	if (only.empty() || only == "dirtymiss")
+		benchDirtyMiss();
+	if (only.empty() || only == "alloc")
+		benchAllocate();
+	if (only.empty() || only == "open")
+		benchOpen();
+	if (only.empty() || only == "bulkload")
+		benchBulkLoad();
+	if (only.empty() || only == "hit")
+		benchHit();
+	if (only.empty() || only == "guard")
+		benchGuard();
+	if (only.empty() || only == "threads")
+		benchThreads();
+	if (only.empty() || only == "latch")
+		benchLatchModes();
+	if (only.empty() || only == "policy")
+		benchPolicies();
+	if (only.empty() || only == "ring")
+		benchRingScan();
+	if (only.empty() || only == "readahead")
+		benchReadAhead();
+	if (only.empty() || only == "batch")
+		benchBatchRead();
+	if (only.empty() || only == "bgwriter")
+		benchBgWriter();
+
+	return 0;
+}
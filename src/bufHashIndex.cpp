@@ -0,0 +1,19 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "bufHashIndex.h"
+#include "exceptions/hash_not_found_exception.h"
+
+namespace badgerdb {
+
+void BufHashIndex::lookup(const File* file, const PageId pageNo, FrameId &frameNo) 
+{
+  if (!find(file, pageNo, frameNo))
+    throw HashNotFoundException(file->filename(), pageNo);
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "file.h"
+
+namespace badgerdb {
+
+/**
+* @brief Interface of the hash tables the buffer manager can use to map (file, page) to frame
+*
+* @warning Implementations are not threadsafe; BufMgr latches each table it uses.
+*/
+class BufHashIndex
+{
+ public:
+	/**
+   * Destructor of BufHashIndex class
+	 */
+  virtual ~BufHashIndex() {}
+
+	/**
+   * Insert entry into hash table mapping (file, pageNo) to frameNo.
+	 *
+	 * @param file   	File object
+	 * @param pageNo 	Page number in the file
+	 * @param frameNo Frame number assigned to that page of the file
+   * @throws  HashAlreadyPresentException	if the corresponding page already exists in the hash table
+   * @throws  HashTableException (optional) if the table has no room for the new entry
+	 */
+  virtual void insert(const File* file, const PageId pageNo, const FrameId frameNo) = 0;
+
+	/**
+   * Check if (file, pageNo) is currently in the buffer pool (ie. in
+   * the hash table) without throwing when it is not.  This is the probe used
+   * on the buffer manager's hot path, where a miss is an expected outcome.
+	 *
+	 * @param file  	File object
+	 * @param pageNo	Page number in the file
+	 * @param frameNo Frame number reference, only assigned if the entry is found
+	 * @return  			True if the page entry is present in the hash table
+	 */
+  virtual bool find(const File* file, const PageId pageNo, FrameId &frameNo) = 0;
+
+	/**
+   * Delete entry (file,pageNo) from hash table.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+   * @throws HashNotFoundException if the page entry is not found in the hash table 
+	 */
+  virtual void remove(const File* file, const PageId pageNo) = 0;
+
+	/**
+   * Check if (file, pageNo) is currently in the buffer pool (ie. in
+   * the hash table).
+	 *
+	 * @param file  	File object
+	 * @param pageNo	Page number in the file
+	 * @param frameNo Frame number reference
+   * @throws HashNotFoundException if the page entry is not found in the hash table 
+	 */
+  void lookup(const File* file, const PageId pageNo, FrameId &frameNo);
+
+	/**
+   * Reports how well the entries are spread over the table.  Entry i of the
+   * histogram is set to the number of entries a successful lookup needs i+1
+   * key comparisons to find.
+	 *
+	 * @param histogram  Filled with the comparison count histogram
+	 */
+  virtual void probeHistogram(std::vector<std::uint32_t> &histogram) const = 0;
+
+	/**
+	 * Mixes file and pageNo into a 64-bit hash value.  The file contributes its
+	 * id rather than its address, and the result goes through a multiply-xorshift
+	 * finalizer so that every input bit affects the low bits used for indexing.
+	 * The buffer manager uses the high bits to pick a hash table shard.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 * @return  			Hash value.
+	 */
+  static std::uint64_t hashKey(const File* file, const PageId pageNo)
+  {
+    std::uint64_t key = ((std::uint64_t)file->id() << 32) | pageNo;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+	/**
+	 * Returns the smallest power of two that is not less than size.
+	 */
+  static std::uint32_t roundUpToPowerOfTwo(const std::uint32_t size)
+  {
+    std::uint32_t rounded = 1;
+    while (rounded < size)
+      rounded <<= 1;
+    return rounded;
+  }
+};
+
+}
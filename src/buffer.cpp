@@ -5,14 +5,24 @@
  * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include "buffer.h"
+#include "flatBufHashTbl.h"
+#include "clockPolicy.h"
+#include "lruKPolicy.h"
+#include "twoQPolicy.h"
+#include "arcPolicy.h"
+#include "clockProPolicy.h"
 #include "exceptions/buffer_exceeded_exception.h"
 #include "exceptions/page_not_pinned_exception.h"
 #include "exceptions/page_pinned_exception.h"
 #include "exceptions/bad_buffer_exception.h"
-#include "exceptions/hash_not_found_exception.h"
 #include "exceptions/invalid_page_exception.h"
 #include "file_iterator.h"
 
@@ -20,8 +30,29 @@
 namespace badgerdb
 {
 
-BufMgr::BufMgr(std::uint32_t bufs)
-	: numBufs(bufs)
+const FrameId BufDesc::INVALID_FRAME;
+
+/**
+ * Identifies a page to the replacement policy, also after it has left the buffer pool.
+ */
+static std::uint64_t pageKey(const File *file, const PageId pageNo)
+{
+	return ((std::uint64_t)file->id() << 32) | pageNo;
+}
+
+/**
+ * Number of pages read ahead on the first miss of a run in page order
+ */
+static const PageId MIN_READ_AHEAD = 4;
+
+/**
+ * Most pages read ahead on one miss
+ */
+static const PageId MAX_READ_AHEAD = 32;
+
+BufMgr::BufMgr(std::uint32_t bufs, HashTableType tableType, std::uint32_t shards,
+							 ReplacementPolicyType policyType)
+	: numBufs(bufs), bgWriterStop(false), bgWriterHand(0)
 {
 	bufDescTable = new BufDesc[bufs]; // describes the frames in the buffer (file, dirty, pin count, etc)
 
@@ -34,186 +65,1103 @@ BufMgr::BufMgr(std::uint32_t bufs)
 
 	bufPool = new Page[bufs]; // the actual buffer of Pages
 
-	int htsize = ((((int)(bufs * 1.2)) * 2) / 2) + 1;
-	hashTable = new BufHashTbl(htsize); // allocate the buffer hash table
+	// each shard gets an equal part of the table size a single table would have
+	numShards = BufHashIndex::roundUpToPowerOfTwo(shards > 0 ? shards : 1);
+	hashShards = new BufHashShard[numShards];
+	for (std::uint32_t i = 0; i < numShards; i++)
+	{
+		if (tableType == FLAT_HASH_TABLE) {
+			// keep the open addressing table at most half full so probe runs stay short
+			hashShards[i].table = new FlatBufHashTbl(bufs * 2 / numShards + 1);
+		}
+		else {
+			int htsize = ((((int)(bufs * 1.2)) * 2) / 2) / numShards + 1;
+			hashShards[i].table = new BufHashTbl(htsize); // allocate the buffer hash table
+		}
+	}
 
-	clockHand = bufs - 1;
+	// every frame starts out free; push them in reverse so frame 0 is handed out first
+	freeFrames.reserve(bufs);
+	for (FrameId i = bufs; i > 0; i--)
+		freeFrames.push_back(i - 1);
+	unpinnedFrames = bufs;
 
-	
+	switch (policyType) {
+	case LRU_K_POLICY:
+		policy = new LruKPolicy(bufDescTable, bufs);
+		break;
+	case TWO_Q_POLICY:
+		policy = new TwoQPolicy(bufDescTable, bufs);
+		break;
+	case ARC_POLICY:
+		policy = new ArcPolicy(bufDescTable, bufs);
+		break;
+	case CLOCK_PRO_POLICY:
+		policy = new ClockProPolicy(bufDescTable, bufs);
+		break;
+	default:
+		policy = new ClockPolicy(bufDescTable, bufs);
+		break;
+	}
 }
 
 BufMgr::~BufMgr()
 {
-	// flush all files in the buffer to disk
-	for (FrameId i = 0; i < numBufs; i++)
-	{
-		if (bufDescTable[i].dirty && bufDescTable[i].valid) {
-			flushFile(bufDescTable[i].file);
-		}
-	}
+	stopBgWriter();
+
+	// write all dirty pages in the buffer to disk, one file at a time
+	for (std::map<const File*, FrameId>::iterator it = fileFrames.begin(); it != fileFrames.end(); ++it)
+		writeBackFile(it->first);
 	delete [] bufDescTable;
 	delete [] bufPool;
-	delete hashTable;
+	for (std::uint32_t i = 0; i < numShards; i++)
+		delete hashShards[i].table;
+	delete [] hashShards;
+	delete policy;
+}
+
+BufHashShard &BufMgr::shardFor(const File *file, const PageId pageNo)
+{
+	// the tables index with the low bits of the hash, so pick the shard with the high bits
+	return hashShards[(BufHashIndex::hashKey(file, pageNo) >> 32) & (numShards - 1)];
+}
+
+void BufMgr::pinFrame(const FrameId frame)
+{
+	BufDesc &desc = bufDescTable[frame];
+	// the first pin of a page read ahead is its first use, which loading it
+	// already stood for; counting it again would make a scan look like reuse
+	const bool firstUse = desc.prefetched && desc.prefetched.exchange(false);
+	if (firstUse)
+		bufStats.prefetchHits++;
+	else
+		desc.refbit = true;
+	if (desc.pinCnt.fetch_add(1) == 0)
+		unpinnedFrames--;
+	if (!firstUse)
+		policy->pagePinned(frame);
+}
+
+bool BufMgr::popFreeFrame(FrameId &frame)
+{
+	std::lock_guard<SpinLatch> guard(freeLatch);
+	if (freeFrames.empty())
+		return false;
+	frame = freeFrames.back();
+	freeFrames.pop_back();
+	bufDescTable[frame].pinCnt = 1;
+	unpinnedFrames--;
+	return true;
 }
 
-void BufMgr::advanceClock()
+bool BufMgr::dropFrame(const FrameId frame, const bool writeBack)
 {
-	// advances the clock hand through the indices of the buffer
-	clockHand = (clockHand + 1) % numBufs;
-	
+	BufDesc &desc = bufDescTable[frame];
+	if (!desc.valid || desc.pinCnt != 0)
+		return false;
+
+	// write the frame to disk before giving up its mapping; if it is dirtied
+	// again while the write is in progress, the check below keeps it resident.
+	// A thread that pinned the page since the check above may be changing it,
+	// so the write waits for no writer to hold the page.
+	if (writeBack && desc.dirty) {
+		if (!desc.pageLatch.try_lock_shared())
+			return false;
+		desc.dirty = false;
+		try {
+			desc.file->writePage(bufPool[frame]);
+		}
+		catch (...) {
+			desc.dirty = true;
+			desc.pageLatch.unlock_shared();
+			throw;
+		}
+		desc.pageLatch.unlock_shared();
+		bufStats.diskwrites++;
+	}
+
+	// readers pin under the shard latch, so an unpinned frame stays unpinned
+	// until its mapping is gone
+	{
+		BufHashShard &shard = shardFor(desc.file, desc.pageNo);
+		std::lock_guard<std::mutex> guard(shard.latch);
+		if (desc.pinCnt != 0 || (writeBack && desc.dirty))
+			return false;
+		shard.table->remove(desc.file, desc.pageNo);
+	}
+	{
+		std::lock_guard<std::mutex> guard(fileLatch);
+		unlinkFileFrame(frame);
+	}
+	policy->pageRemoved(frame);
+	if (desc.prefetched) {
+		bufStats.prefetchWasted++;
+		shrinkReadAhead(desc.file);
+	}
+	desc.Clear();
+	return true;
 }
 
-void BufMgr::allocBuf(FrameId &frame)
+bool BufMgr::reuseRingFrame(BufAccessStrategy *strategy, FrameId &frame)
 {
-	// check whether all frames are pinned
-	bool allPinned = true;
-	uint32_t i;
-	for (i = 0; i < numBufs; i++) {
-		if (bufDescTable[i].pinCnt == 0) {
-			allPinned = false;
+	strategy->current = (strategy->current + 1) % ringSize(strategy);
+	const BufAccessStrategy::RingSlot &slot = strategy->ring[strategy->current];
+	if (slot.file == NULL)
+		return false;
+
+	BufDesc &desc = bufDescTable[slot.frame];
+	if (desc.pinCnt != 0 || !desc.latch.try_lock())
+		return false;
+
+	// the frame may have been replaced since, and now hold a page of somebody else
+	bool dropped = false;
+	const bool dirty = desc.dirty;
+	if (desc.valid && desc.file == slot.file && desc.pageNo == slot.pageNo) {
+		try {
+			dropped = dropFrame(slot.frame, true);
 		}
-	} 
-	// if they are, throw an exception
-	if (allPinned)
+		catch (...) {
+			desc.latch.unlock();
+			throw;
+		}
+	}
+	if (dropped) {
+		desc.pinCnt = 1;
+		unpinnedFrames--;
+		frame = slot.frame;
+		strategy->reused++;
+		if (dirty)
+			bufStats.fgwrites++;
+	}
+	desc.latch.unlock();
+	return dropped;
+}
+
+std::uint32_t BufMgr::ringSize(const BufAccessStrategy *strategy) const
+{
+	// like a pool of its own, the ring may not take more than an eighth of the frames
+	return std::min<std::uint32_t>(strategy->ring.size(), std::max<std::uint32_t>(numBufs / 8, 1));
+}
+
+void BufMgr::allocBuf(FrameId &frame, BufAccessStrategy *strategy)
+{
+	// a scan with a ring of its own recycles the frame it used one lap ago
+	if (strategy != NULL && reuseRingFrame(strategy, frame))
+		return;
+
+	// hand out a frame that holds no page, if there is one
+	if (popFreeFrame(frame))
+		return;
+
+	// every frame holds a page; if they are all pinned, none can be replaced
+	if (unpinnedFrames == 0)
 		throw BufferExceededException();
 
-	// search for a frame that can be replaced
-	uint32_t ticks = 0;
-	bool found = false;
-	while (ticks < numBufs*2 && !found) {
-		advanceClock();
-
-		// immediately select frame if invalid
-		if (!bufDescTable[clockHand].valid)
-			found = true;
-
-		// clear refbits found that are set
-		else if (bufDescTable[clockHand].refbit)
-			bufDescTable[clockHand].refbit = false; 
-		
-		// found valid frame that is not pinned with refbit not set
-		else if (bufDescTable[clockHand].pinCnt == 0)
-				found = true;
-		
-		ticks++;
-	}
-	
-	// write the frame to disk before clearing it, if necessary
-	if (bufDescTable[clockHand].dirty)
-		bufDescTable[clockHand].file->writePage(bufPool[clockHand]);
-	
-	// remove the file and page number from tables
-	if (bufDescTable[clockHand].valid)
-		hashTable->remove(bufDescTable[clockHand].file, bufDescTable[clockHand].pageNo);
-	bufDescTable[clockHand].Clear();
-	// set the passed frameId to the newly allocated frame
-	frame = clockHand;
-}
-
-void BufMgr::readPage(File *file, const PageId pageNo, Page *&page) {
+	// ask the policy for a frame to replace. The frame it names may have been
+	// pinned, or be being worked on by another thread, by the time we get to
+	// it, so keep asking for a while.
+	for (uint32_t attempts = 0; attempts < numBufs; attempts++) {
+		FrameId candidate;
+		if (!policy->pickVictim(candidate))
+			break;
+		BufDesc &desc = bufDescTable[candidate];
 
-	FrameId frameNo = 0;
-	try { 
+		// skip pinned frames
+		if (desc.pinCnt != 0) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// a policy may keep naming the frame another thread is replacing, so wait
+		// for that thread rather than spend our attempts on it. No latch is held
+		// here, and dropFrame rechecks the pin count.
+		desc.latch.lock();
+
+		bool dropped;
+		const bool dirty = desc.dirty;
+		try {
+			dropped = dropFrame(candidate, true);
+		}
+		catch (...) {
+			desc.latch.unlock();
+			throw;
+		}
+		if (dropped) {
+			desc.pinCnt = 1;
+			unpinnedFrames--;
+			desc.latch.unlock();
+			if (dirty)
+				bufStats.fgwrites++;
+			// set the passed frameId to the newly allocated frame
+			frame = candidate;
+			return;
+		}
+		desc.latch.unlock();
+	}
+	throw BufferExceededException();
+}
+
+void BufMgr::releaseBuf(const FrameId frame)
+{
+	bufDescTable[frame].Clear();
+	unpinnedFrames++;
+	std::lock_guard<SpinLatch> guard(freeLatch);
+	freeFrames.push_back(frame);
+}
+
+void BufMgr::installPage(File *file, const PageId pageNo, FrameId &frame)
+{
+	BufDesc &desc = bufDescTable[frame];
+	FrameId existing = 0;
+	{
+		std::lock_guard<SpinLatch> descGuard(desc.latch);
+		BufHashShard &shard = shardFor(file, pageNo);
+		std::unique_lock<std::mutex> shardGuard(shard.latch);
+		if (!shard.table->find(file, pageNo, existing)) {
+			// insert it into the hashtable and bufDescTable so we know its there,
+			// telling the policy first so that a hit cannot pin it before it is loaded
+			desc.Set(file, pageNo);
+			policy->pageLoaded(frame, pageKey(file, pageNo));
+			shard.table->insert(file, pageNo, frame);
+			shardGuard.unlock();
+			std::lock_guard<std::mutex> fileGuard(fileLatch);
+			linkFileFrame(frame);
+			return;
+		}
+		// another thread brought the page in while we were reading it
+		pinFrame(existing);
+	}
+	releaseBuf(frame);
+	frame = existing;
+}
+
+void BufMgr::linkFileFrame(const FrameId frame)
+{
+	// push the frame on the front of its file's list
+	std::map<const File*, FrameId>::iterator it = fileFrames.find(bufDescTable[frame].file);
+	if (it == fileFrames.end()) {
+		fileFrames[bufDescTable[frame].file] = frame;
+		return;
+	}
+	bufDescTable[frame].nextInFile = it->second;
+	bufDescTable[it->second].prevInFile = frame;
+	it->second = frame;
+}
+
+void BufMgr::unlinkFileFrame(const FrameId frame)
+{
+	BufDesc &desc = bufDescTable[frame];
+	if (desc.prevInFile != BufDesc::INVALID_FRAME)
+		bufDescTable[desc.prevInFile].nextInFile = desc.nextInFile;
+	else if (desc.nextInFile != BufDesc::INVALID_FRAME)
+		fileFrames[desc.file] = desc.nextInFile;
+	else
+		fileFrames.erase(desc.file); // last frame of the file
+	if (desc.nextInFile != BufDesc::INVALID_FRAME)
+		bufDescTable[desc.nextInFile].prevInFile = desc.prevInFile;
+	desc.nextInFile = BufDesc::INVALID_FRAME;
+	desc.prevInFile = BufDesc::INVALID_FRAME;
+}
+
+FrameId BufMgr::firstFileFrame(const File *file)
+{
+	std::lock_guard<std::mutex> guard(fileLatch);
+	std::map<const File*, FrameId>::iterator it = fileFrames.find(file);
+	return it == fileFrames.end() ? BufDesc::INVALID_FRAME : it->second;
+}
+
+bool BufMgr::claimPage(File *file, const PageId pageNo, const FrameId frame, FrameId &existing)
+{
+	BufDesc &desc = bufDescTable[frame];
+	std::lock_guard<SpinLatch> descGuard(desc.latch);
+	{
+		BufHashShard &shard = shardFor(file, pageNo);
+		std::lock_guard<std::mutex> shardGuard(shard.latch);
+		if (shard.table->find(file, pageNo, existing)) {
+			// another thread got to the page first
+			pinFrame(existing);
+			return false;
+		}
+		// nobody else holds the new frame, so the latch is ours at once
+		desc.pageLatch.lock();
+		desc.ioPending = true;
+		desc.Set(file, pageNo);
+		// the policy learns of the page before a hit can pin it
+		policy->pageLoaded(frame, pageKey(file, pageNo));
+		shard.table->insert(file, pageNo, frame);
+	}
+	std::lock_guard<std::mutex> fileGuard(fileLatch);
+	linkFileFrame(frame);
+	return true;
+}
+
+void BufMgr::abandonRead(const FrameId frame)
+{
+	BufDesc &desc = bufDescTable[frame];
+	{
+		std::lock_guard<SpinLatch> descGuard(desc.latch);
+		{
+			BufHashShard &shard = shardFor(desc.file, desc.pageNo);
+			std::lock_guard<std::mutex> shardGuard(shard.latch);
+			shard.table->remove(desc.file, desc.pageNo);
+		}
+		{
+			std::lock_guard<std::mutex> fileGuard(fileLatch);
+			unlinkFileFrame(frame);
+		}
+		policy->pageRemoved(frame);
+		desc.valid = false;
+		desc.readFailed = true;
+	}
+	desc.ioPending = false;
+	desc.pageLatch.unlock();
+
+	// threads that waited for the read see it failed and unpin the frame
+	while (desc.pinCnt > 1)
+		std::this_thread::yield();
+	releaseBuf(frame);
+}
+
+bool BufMgr::waitForRead(const FrameId frame, const LatchMode mode)
+{
+	BufDesc &desc = bufDescTable[frame];
+	if (mode == LATCH_SHARED)
+		desc.pageLatch.lock_shared();
+	else if (mode == LATCH_EXCLUSIVE)
+		desc.pageLatch.lock();
+	else if (desc.ioPending) {
+		// the reading thread holds the latch until the page is in
+		desc.pageLatch.lock_shared();
+		desc.pageLatch.unlock_shared();
+	}
+
+	if (desc.readFailed) {
+		unpinFrame(frame, false, mode);
+		return false;
+	}
+	return true;
+}
+
+FrameId BufMgr::fetchFrame(File *file, const PageId pageNo, const LatchMode mode, BufAccessStrategy *strategy) {
+
+	bufStats.accesses++;
+	for (;;) {
+		FrameId frameNo = 0;
 		// lookup the file and page number in the hashtable
-		hashTable->lookup(file, pageNo, frameNo);
-		// if it exists, the related frame number will be given. if not, catch statement will execute
-		bufDescTable[frameNo].refbit = true;
-		bufDescTable[frameNo].pinCnt++;
-		page = &bufPool[frameNo];
+		bool resident;
+		{
+			BufHashShard &shard = shardFor(file, pageNo);
+			std::lock_guard<std::mutex> guard(shard.latch);
+			resident = shard.table->find(file, pageNo, frameNo);
+			// the page is already in the buffer, so just pin it again
+			if (resident)
+				pinFrame(frameNo);
+		}
+
+		if (!resident) {
+			// if the file's page is not already in the buffer, allocate a frame
+			allocBuf(frameNo, strategy);
+			FrameId existing = 0;
+			if (!claimPage(file, pageNo, frameNo, existing)) {
+				// another thread is reading the page, or has read it, while we got a frame
+				releaseBuf(frameNo);
+				frameNo = existing;
+				resident = true;
+			}
+		}
+
+		// the pin keeps the frame from being reused while we wait for the read and the latch
+		if (resident) {
+			if (waitForRead(frameNo, mode))
+				return frameNo;
+			continue;
+		}
 
+		// we are the only thread reading the page; the others wait for the page
+		// latch. The pages that follow it are read along with it if the file is
+		// being read in page order, into frames claimed for them beforehand, so
+		// that nobody else reads them meanwhile.
+		if (strategy != NULL)
+			strategy->remember(frameNo, file, pageNo);
+		std::vector<FrameId> ahead;
+		std::vector<Page> pages;
+		try {
+			const PageId window = readAheadWindow(file, pageNo, strategy);
+			if (window > 0)
+				claimReadAhead(file, pageNo, window, strategy, ahead);
+			if (ahead.empty()) {
+				bufPool[frameNo] = file->readPage(pageNo);
+				bufStats.diskreads++;
+			}
+			else {
+				pages = file->readPages(pageNo, ahead.size() + 1);
+				bufPool[frameNo] = std::move(pages[0]);
+				bufStats.diskreads += pages.size();
+			}
+		}
+		catch (...) {
+			for (std::size_t i = 0; i < ahead.size(); i++)
+				abandonRead(ahead[i]);
+			abandonRead(frameNo);
+			throw;
+		}
+		bufDescTable[frameNo].ioPending = false;
+		if (mode != LATCH_EXCLUSIVE) {
+			bufDescTable[frameNo].pageLatch.unlock();
+			if (mode == LATCH_SHARED)
+				bufDescTable[frameNo].pageLatch.lock_shared();
+		}
+
+		if (!ahead.empty())
+			installReadAhead(pageNo, pages, ahead);
+		return frameNo;
 	}
-	catch (HashNotFoundException e) {
-		// if the file's page is not already in the buffer, allocate a frame
-		allocBuf(frameNo);
-		// read the page into the newly allocated frame in the buffer
-		bufPool[frameNo] = file->readPage(pageNo);
-		// insert it into the hashtable and bufDescTable so we know its there
-		hashTable->insert(file, pageNo, frameNo);
-		bufDescTable[frameNo].Set(file, pageNo);
-		page = &bufPool[frameNo];
+}
+
+void BufMgr::fetchFrames(File *file, const std::vector<PageId> &pageNos, std::vector<FrameId> &frames,
+												 const bool prefetching)
+{
+	// each page is looked up and read once, in page number order
+	std::vector<PageId> unique(pageNos);
+	std::sort(unique.begin(), unique.end());
+	unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+	std::vector<FrameId> uniqueFrames(unique.size(), BufDesc::INVALID_FRAME);
+	std::vector<bool> claimed(unique.size(), false);
+
+	try {
+		// pin the pages that are in, and claim a frame for each of the others
+		for (std::size_t i = 0; i < unique.size(); i++) {
+			FrameId frameNo = 0;
+			{
+				BufHashShard &shard = shardFor(file, unique[i]);
+				std::lock_guard<std::mutex> guard(shard.latch);
+				if (shard.table->find(file, unique[i], frameNo)) {
+					if (!prefetching) {
+						pinFrame(frameNo);
+						uniqueFrames[i] = frameNo;
+					}
+					continue;
+				}
+			}
+
+			try {
+				allocBuf(frameNo, NULL);
+			}
+			catch (BufferExceededException &) {
+				if (prefetching)
+					break;
+				throw;
+			}
+			FrameId existing = 0;
+			if (claimPage(file, unique[i], frameNo, existing)) {
+				uniqueFrames[i] = frameNo;
+				claimed[i] = true;
+			}
+			else {
+				releaseBuf(frameNo);
+				if (prefetching)
+					unpinFrame(existing, false, LATCH_NONE);
+				else
+					uniqueFrames[i] = existing;
+			}
+		}
+
+		// read the claimed pages with one read per run of consecutive page numbers
+		std::size_t i = 0;
+		while (i < unique.size()) {
+			if (!claimed[i]) {
+				i++;
+				continue;
+			}
+			std::size_t end = i + 1;
+			// a run stops at the end of a bitmap group, where the pages are not next to each other on disk
+			while (end < unique.size() && claimed[end] && unique[end] == unique[end - 1] + 1 &&
+						 unique[end] < File::groupEnd(unique[i]))
+				end++;
+
+			std::vector<Page> pages;
+			try {
+				pages = file->readPages(unique[i], unique[end - 1] - unique[i] + 1);
+			}
+			catch (InvalidPageException &) {
+				// the run starts with a page that is not in the file; read the rest of it on its own
+				claimed[i] = false;
+				abandonRead(uniqueFrames[i]);
+				uniqueFrames[i] = BufDesc::INVALID_FRAME;
+				i++;
+				continue;
+			}
+			bufStats.diskreads += pages.size();
+
+			std::size_t next = 0;
+			for (; i < end; i++) {
+				BufDesc &desc = bufDescTable[uniqueFrames[i]];
+				claimed[i] = false;
+				if (next < pages.size() && pages[next].page_number() == unique[i]) {
+					bufPool[uniqueFrames[i]] = std::move(pages[next++]);
+					if (prefetching) {
+						desc.prefetched = true;
+						bufStats.prefetched++;
+					}
+					desc.ioPending = false;
+					desc.pageLatch.unlock();
+				}
+				else {
+					// not used, or past the end of the file
+					abandonRead(uniqueFrames[i]);
+					uniqueFrames[i] = BufDesc::INVALID_FRAME;
+				}
+			}
+		}
+
+		// pages other threads were reading have to be in before they are used
+		for (i = 0; i < unique.size(); i++) {
+			if (uniqueFrames[i] == BufDesc::INVALID_FRAME || waitForRead(uniqueFrames[i], LATCH_NONE))
+				continue;
+			// their read failed; find out for ourselves whether the page is in the file
+			uniqueFrames[i] = BufDesc::INVALID_FRAME;
+			try {
+				uniqueFrames[i] = fetchFrame(file, unique[i], LATCH_NONE, NULL);
+			}
+			catch (InvalidPageException &) {
+			}
+		}
+	}
+	catch (...) {
+		for (std::size_t i = 0; i < unique.size(); i++) {
+			if (claimed[i])
+				abandonRead(uniqueFrames[i]);
+			else if (uniqueFrames[i] != BufDesc::INVALID_FRAME)
+				unpinFrame(uniqueFrames[i], false, LATCH_NONE);
+		}
+		throw;
 	}
 
+	// hand out the pins, pinning pages that appear more than once again
+	std::vector<bool> handedOut(unique.size(), false);
+	frames.resize(pageNos.size());
+	for (std::size_t k = 0; k < pageNos.size(); k++) {
+		const std::size_t i = std::lower_bound(unique.begin(), unique.end(), pageNos[k]) - unique.begin();
+		frames[k] = uniqueFrames[i];
+		if (frames[k] == BufDesc::INVALID_FRAME)
+			continue;
+		if (handedOut[i]) {
+			BufHashShard &shard = shardFor(file, unique[i]);
+			std::lock_guard<std::mutex> guard(shard.latch);
+			pinFrame(frames[k]);
+		}
+		handedOut[i] = true;
+	}
 }
 
-void BufMgr::unPinPage(File *file, const PageId pageNo, const bool dirty)
+void BufMgr::readPages(File *file, const std::vector<PageId> &pageNos, std::vector<Page*> &pages)
 {
-	// find the page in the table, set it's dirty property in the desc table if necessary, and decrement its pin count
-	try { 
+	bufStats.accesses += pageNos.size();
+	std::vector<FrameId> frames;
+	fetchFrames(file, pageNos, frames, false);
+
+	// like readPage(), fail on a page that is not in the file, pinning none of the batch
+	for (std::size_t k = 0; k < frames.size(); k++) {
+		if (frames[k] != BufDesc::INVALID_FRAME)
+			continue;
+		for (std::size_t j = 0; j < frames.size(); j++) {
+			if (frames[j] != BufDesc::INVALID_FRAME)
+				unpinFrame(frames[j], false, LATCH_NONE);
+		}
+		throw InvalidPageException(pageNos[k], file->filename());
+	}
+
+	pages.resize(frames.size());
+	for (std::size_t k = 0; k < frames.size(); k++)
+		pages[k] = &bufPool[frames[k]];
+}
+
+void BufMgr::prefetch(File *file, const std::vector<PageId> &pageNos)
+{
+	std::vector<FrameId> frames;
+	fetchFrames(file, pageNos, frames, true);
+	for (std::size_t k = 0; k < frames.size(); k++) {
+		if (frames[k] != BufDesc::INVALID_FRAME)
+			unpinFrame(frames[k], false, LATCH_NONE);
+	}
+}
+
+PageId BufMgr::readAheadWindow(const File *file, const PageId pageNo, const BufAccessStrategy *strategy)
+{
+	// pages read ahead may not take more than a sixteenth of the pool, nor more
+	// than half of the ring they go into, or they would push each other out
+	PageId limit = std::min<PageId>(MAX_READ_AHEAD, numBufs / 16);
+	if (strategy != NULL)
+		limit = std::min<PageId>(limit, ringSize(strategy) / 2);
+	if (limit < MIN_READ_AHEAD)
+		return 0;
+
+	std::lock_guard<std::mutex> guard(readAheadLatch);
+	ReadAheadState &state = readAheadFiles[file];
+	PageId window = 0;
+	if (state.pattern == ACCESS_SEQUENTIAL)
+		window = limit;
+	else if (state.pattern == ACCESS_NORMAL && pageNo == state.nextPage)
+		window = std::min<PageId>(state.window == 0 ? MIN_READ_AHEAD : state.window * 2, limit);
+	state.window = window;
+	// read no further than the end of the page's bitmap group, which the next miss then starts from
+	window = std::min<PageId>(window, File::groupEnd(pageNo) - pageNo - 1);
+	state.nextPage = pageNo + window + 1;
+	return window;
+}
+
+void BufMgr::claimReadAhead(File *file, const PageId pageNo, const PageId window, BufAccessStrategy *strategy,
+														std::vector<FrameId> &frames)
+{
+	// stop at the first page that is in the buffer pool or being read, so the
+	// claimed pages follow the missed one without a gap
+	for (PageId aheadNo = pageNo + 1; aheadNo <= pageNo + window; aheadNo++) {
 		FrameId frameNo = 0;
-		hashTable->lookup(file, pageNo, frameNo);
-		if (dirty)
-			bufDescTable[frameNo].dirty = true;
+		{
+			BufHashShard &shard = shardFor(file, aheadNo);
+			std::lock_guard<std::mutex> guard(shard.latch);
+			if (shard.table->find(file, aheadNo, frameNo))
+				return;
+		}
+
+		// pages read ahead are not worth waiting for a frame
+		try {
+			allocBuf(frameNo, strategy);
+		}
+		catch (BufferExceededException &) {
+			return;
+		}
+		FrameId existing = 0;
+		if (!claimPage(file, aheadNo, frameNo, existing)) {
+			releaseBuf(frameNo);
+			unpinFrame(existing, false, LATCH_NONE);
+			return;
+		}
+		if (strategy != NULL)
+			strategy->remember(frameNo, file, aheadNo);
+		frames.push_back(frameNo);
+	}
+}
+
+void BufMgr::installReadAhead(const PageId pageNo, std::vector<Page> &pages, const std::vector<FrameId> &frames)
+{
+	// pages[0] is the page that missed; the rest are the used pages that followed it
+	std::size_t next = 1;
+	for (std::size_t i = 0; i < frames.size(); i++) {
+		BufDesc &desc = bufDescTable[frames[i]];
+		if (next < pages.size() && pages[next].page_number() == pageNo + 1 + i) {
+			bufPool[frames[i]] = std::move(pages[next++]);
+			desc.prefetched = true;
+			bufStats.prefetched++;
+			desc.ioPending = false;
+			desc.pageLatch.unlock();
+			unpinFrame(frames[i], false, LATCH_NONE);
+		}
+		else {
+			// not used, or past the end of the file
+			abandonRead(frames[i]);
+		}
+	}
+}
+
+void BufMgr::shrinkReadAhead(const File *file)
+{
+	std::lock_guard<std::mutex> guard(readAheadLatch);
+	std::map<const File*, ReadAheadState>::iterator it = readAheadFiles.find(file);
+	if (it != readAheadFiles.end())
+		it->second.window /= 2;
+}
+
+void BufMgr::adviseAccess(const File *file, const AccessPattern pattern)
+{
+	std::lock_guard<std::mutex> guard(readAheadLatch);
+	ReadAheadState &state = readAheadFiles[file];
+	state.pattern = pattern;
+	state.window = 0;
+}
+
+void BufMgr::readPage(File *file, const PageId pageNo, Page *&page, const LatchMode mode,
+											BufAccessStrategy *strategy)
+{
+	page = &bufPool[fetchFrame(file, pageNo, mode, strategy)];
+}
+
+PageGuard BufMgr::fetchPage(File *file, const PageId pageNo, const LatchMode mode,
+														BufAccessStrategy *strategy)
+{
+	FrameId frameNo = fetchFrame(file, pageNo, mode, strategy);
+	return PageGuard(this, frameNo, &bufPool[frameNo], mode);
+}
+
+void BufMgr::unpinFrame(const FrameId frame, const bool dirty, const LatchMode mode)
+{
+	BufDesc &desc = bufDescTable[frame];
+	// mark the page dirty before the pin goes, so an evictor that sees it unpinned writes it back
+	if (dirty)
+		desc.dirty = true;
+
+	// let go of the page before the pin, while the frame still holds it
+	if (mode == LATCH_SHARED)
+		desc.pageLatch.unlock_shared();
+	else if (mode == LATCH_EXCLUSIVE)
+		desc.pageLatch.unlock();
+
+	if (desc.pinCnt.fetch_sub(1) == 1)
+		unpinnedFrames++;
+}
+
+void BufMgr::unPinPage(File *file, const PageId pageNo, const bool dirty, const LatchMode mode)
+{
+	// find the page in the table, set it's dirty property in the desc table if necessary, and decrement its pin count
+	FrameId frameNo = 0;
+	{
+		BufHashShard &shard = shardFor(file, pageNo);
+		std::lock_guard<std::mutex> guard(shard.latch);
+		if (!shard.table->find(file, pageNo, frameNo))
+			return; // nothing to unpin if the page is not in the buffer
 		if (bufDescTable[frameNo].pinCnt == 0)
 			throw PageNotPinnedException(file->filename(), pageNo, frameNo);
+	}
+
+	// our pin keeps the frame holding the page from here on
+	unpinFrame(frameNo, dirty, mode);
+}
 
-		bufDescTable[frameNo].pinCnt--;
+std::uint32_t BufMgr::beginOptimisticRead(const Page *page) const
+{
+	return bufDescTable[page - bufPool].pageLatch.readVersion();
+}
+
+bool BufMgr::validateOptimisticRead(const Page *page, const std::uint32_t version) const
+{
+	return bufDescTable[page - bufPool].pageLatch.validate(version);
+}
+
+void BufMgr::checkFileUnpinned(const File *file)
+{
+	std::lock_guard<std::mutex> guard(fileLatch);
+	std::map<const File*, FrameId>::iterator it = fileFrames.find(file);
+	if (it == fileFrames.end())
+		return;
+
+	// check that every frame of the file has a pin count of 0 and is valid
+	for (FrameId i = it->second; i != BufDesc::INVALID_FRAME; i = bufDescTable[i].nextInFile) {
+		if (bufDescTable[i].pinCnt > 0) {
+			// can't dispose of a file that's still pinned
+			throw PagePinnedException(file->filename(),bufDescTable[i].pageNo, bufDescTable[i].frameNo);
+		}
+		else if (bufDescTable[i].valid == 0) {
+			throw BadBufferException(bufDescTable[i].frameNo, bufDescTable[i].dirty, bufDescTable[i].valid, bufDescTable[i].refbit);
+		}
+	}
+}
+
+std::uint32_t BufMgr::writeBackFile(const File *file)
+{
+	std::vector<FrameId> candidates;
+	{
+		std::lock_guard<std::mutex> guard(fileLatch);
+		std::map<const File*, FrameId>::iterator it = fileFrames.find(file);
+		if (it == fileFrames.end())
+			return 0;
+		for (FrameId i = it->second; i != BufDesc::INVALID_FRAME; i = bufDescTable[i].nextInFile)
+			if (bufDescTable[i].dirty)
+				candidates.push_back(i);
 	}
-	catch (InvalidPageException e){
-		// std::cout << "An attempt was made to access an unpin an invalid page in a file." << std::endl;
+
+	// pin each page, so its frame is not evicted and loaded with another page
+	// while the write reads it, and hold it with a shared latch so nobody
+	// changes it meanwhile. The frame is pinned under its descriptor latch,
+	// which dropFrame's callers hold too.
+	std::vector<std::pair<PageId, FrameId> > dirtyPages;
+	File *target = NULL;
+	for (std::size_t i = 0; i < candidates.size(); i++) {
+		BufDesc &desc = bufDescTable[candidates[i]];
+		std::lock_guard<SpinLatch> guard(desc.latch);
+		if (!desc.valid || desc.file != file || !desc.dirty || !desc.pageLatch.try_lock_shared())
+			continue;
+		if (desc.pinCnt.fetch_add(1) == 0)
+			unpinnedFrames--;
+		desc.dirty = false;
+		target = desc.file;
+		dirtyPages.push_back(std::make_pair(desc.pageNo, candidates[i]));
 	}
+	if (dirtyPages.empty())
+		return 0;
 
+	std::sort(dirtyPages.begin(), dirtyPages.end());
+	std::vector<const Page*> pages;
+	pages.reserve(dirtyPages.size());
+	for (std::size_t i = 0; i < dirtyPages.size(); i++)
+		pages.push_back(&bufPool[dirtyPages[i].second]);
+	try {
+		target->writePages(pages);
+		target->sync();
+	}
+	catch (...) {
+		// we don't know how far the write got, or whether it reached the disk,
+		// so all of the pages are dirty again; the pins kept them in their frames
+		for (std::size_t i = 0; i < dirtyPages.size(); i++)
+			unpinFrame(dirtyPages[i].second, true, LATCH_SHARED);
+		throw;
+	}
+	for (std::size_t i = 0; i < dirtyPages.size(); i++)
+		unpinFrame(dirtyPages[i].second, false, LATCH_SHARED);
+	bufStats.diskwrites += dirtyPages.size();
+	return dirtyPages.size();
 }
 
-void BufMgr::flushFile(const File *file)
+void BufMgr::dropFile(const File *file, const bool writeBack)
 {
-	uint32_t i;
-	// check that the file exists somewhere in the buffer, and has a pin count of 0 and is valid
-	for (i = 0; i < numBufs; i++) {
-		if (bufDescTable[i].file == file ) {
-			if (bufDescTable[i].pinCnt > 0) {
-				// can't dispose of a file that's still pinned
-				throw PagePinnedException(file->filename(),bufDescTable[i].pageNo, bufDescTable[i].frameNo);
-			}
-			else if (bufDescTable[i].valid == 0) {
-				throw BadBufferException(bufDescTable[i].frameNo, bufDescTable[i].dirty, bufDescTable[i].valid, bufDescTable[i].refbit);
-			}
+	checkFileUnpinned(file);
+	if (writeBack)
+		writeBackFile(file);
+
+	// dropping the last frame of the file erases its list, so walk until it is gone
+	FrameId i;
+	while ((i = firstFileFrame(file)) != BufDesc::INVALID_FRAME) {
+		BufDesc &desc = bufDescTable[i];
+		std::lock_guard<SpinLatch> guard(desc.latch);
+		// the frame may have been evicted before we got its latch
+		if (!desc.valid || desc.file != file)
+			continue;
+		if (desc.pinCnt > 0)
+			throw PagePinnedException(file->filename(), desc.pageNo, desc.frameNo);
+		if (dropFrame(i, writeBack)) {
+			std::lock_guard<SpinLatch> freeGuard(freeLatch);
+			freeFrames.push_back(i);
 		}
 	}
-	
-	for (i = 0; i < numBufs; i++) {
-		if (bufDescTable[i].file == file) {
-			File *file = bufDescTable[i].file;
-			// if the frame is dirty, indicating changes should be propogated to disk, then write them
-			if (bufDescTable[i].dirty == true) {
-				file->writePage(bufPool[i]);
-				bufDescTable[i].dirty = false;
+
+	// the file may be closed now; keep only what it was advised
+	std::lock_guard<std::mutex> guard(readAheadLatch);
+	std::map<const File*, ReadAheadState>::iterator it = readAheadFiles.find(file);
+	if (it != readAheadFiles.end()) {
+		if (it->second.pattern == ACCESS_NORMAL)
+			readAheadFiles.erase(it);
+		else {
+			it->second.nextPage = Page::INVALID_NUMBER;
+			it->second.window = 0;
+		}
+	}
+}
+
+void BufMgr::startBgWriter(const BgWriterConfig &config)
+{
+	std::lock_guard<std::mutex> guard(bgWriterLatch);
+	bgWriterConfig = config;
+	if (bgWriter.joinable())
+		return;
+	bgWriterStop = false;
+	bgWriter = std::thread(&BufMgr::runBgWriter, this);
+}
+
+void BufMgr::stopBgWriter()
+{
+	{
+		std::lock_guard<std::mutex> guard(bgWriterLatch);
+		if (!bgWriter.joinable())
+			return;
+		bgWriterStop = true;
+	}
+	bgWriterWake.notify_all();
+	bgWriter.join();
+}
+
+void BufMgr::runBgWriter()
+{
+	std::unique_lock<std::mutex> guard(bgWriterLatch);
+	while (!bgWriterStop) {
+		const BgWriterConfig config = bgWriterConfig;
+		guard.unlock();
+		cleanAhead(config);
+		guard.lock();
+		bgWriterWake.wait_for(guard, std::chrono::milliseconds(config.roundMs), [this] { return bgWriterStop; });
+	}
+}
+
+std::uint32_t BufMgr::cleanAhead(const BgWriterConfig &config)
+{
+	// start where the policy will look next, so the frames cleaned are the ones it is about to take
+	FrameId start;
+	if (policy->sweepPosition(start))
+		bgWriterHand = start;
+
+	// free frames are as good as clean ones
+	std::uint32_t clean;
+	{
+		std::lock_guard<SpinLatch> guard(freeLatch);
+		clean = freeFrames.size();
+	}
+
+	std::uint32_t written = 0;
+	for (std::uint32_t n = 0; n < numBufs && clean < config.cleanTarget && written < config.maxPagesPerRound; n++) {
+		const FrameId frame = bgWriterHand;
+		bgWriterHand = (bgWriterHand + 1) % numBufs;
+		BufDesc &desc = bufDescTable[frame];
+		if (!policy->likelyVictim(frame))
+			continue;
+		if (!desc.dirty) {
+			clean++;
+			continue;
+		}
+
+		// leave frames another thread is working on, and pages being changed, for the next round
+		if (!desc.latch.try_lock())
+			continue;
+		bool wrote = false;
+		if (desc.valid && desc.pinCnt == 0 && desc.dirty && desc.pageLatch.try_lock_shared()) {
+			// as in dropFrame(), a page dirtied again while it is written stays dirty
+			desc.dirty = false;
+			try {
+				desc.file->writePage(bufPool[frame]);
+				wrote = true;
+			}
+			catch (...) {
+				// nobody to tell; the thread replacing the page writes it and sees the error
+				desc.dirty = true;
 			}
-			// remove the file from the tables
-			hashTable->remove(file, bufDescTable[i].pageNo);
-			bufDescTable[i].Clear();
+			desc.pageLatch.unlock_shared();
+		}
+		desc.latch.unlock();
+		if (wrote) {
+			written++;
+			clean++;
+			bufStats.diskwrites++;
+			bufStats.bgwrites++;
 		}
 	}
+	return written;
+}
+
+void BufMgr::flushFile(const File *file)
+{
+	// write back the dirty pages of the file and remove all of them from the buffer
+	dropFile(file, true);
+}
+
+std::uint32_t BufMgr::flushDirty(const File *file)
+{
+	return writeBackFile(file);
+}
+
+void BufMgr::evictFile(const File *file)
+{
+	// drop the frames, including any changes that were never written
+	dropFile(file, false);
 }
 
-void BufMgr::allocPage(File *file, PageId &pageNo, Page *&page)
+FrameId BufMgr::allocFrame(File *file, PageId &pageNo, BufAccessStrategy *strategy)
 {
 	// allocates a page within a file, and inserts the file and page into the buffer
 	Page newPage = file->allocatePage();
+	bufStats.accesses++;
+	bufStats.diskreads++;
 	FrameId frameNo;
-	allocBuf(frameNo);
+	allocBuf(frameNo, strategy);
 	pageNo = newPage.page_number();
-	hashTable->insert(file, pageNo, frameNo);
-	bufDescTable[frameNo].Set(file, pageNo);
 	bufPool[frameNo] = newPage;
-	page = &bufPool[frameNo];
-	
+	installPage(file, pageNo, frameNo);
+	if (strategy != NULL)
+		strategy->remember(frameNo, file, pageNo);
+	return frameNo;
+}
+
+void BufMgr::allocPage(File *file, PageId &pageNo, Page *&page, BufAccessStrategy *strategy)
+{
+	page = &bufPool[allocFrame(file, pageNo, strategy)];
+}
+
+PageGuard BufMgr::newPage(File *file, PageId &pageNo, BufAccessStrategy *strategy)
+{
+	FrameId frameNo = allocFrame(file, pageNo, strategy);
+	return PageGuard(this, frameNo, &bufPool[frameNo], LATCH_NONE);
 }
 
 void BufMgr::disposePage(File *file, const PageId PageNo)
 {
 	// removes the given page from the tables we use to keep track of the buffer, then deletes it from the file
 	FrameId  frameNo = 0;
-	try {
-		hashTable->lookup(file, PageNo, frameNo);
-		bufDescTable[frameNo].Clear();
-		hashTable->remove(file, PageNo);
-	}	
-	catch (HashNotFoundException e) {
-		// std::cout << "HashNotFoundException BufMgr::disposePage(File *file, const PageId PageNo)" << std::endl;
+	bool resident;
+	{
+		BufHashShard &shard = shardFor(file, PageNo);
+		std::lock_guard<std::mutex> guard(shard.latch);
+		resident = shard.table->find(file, PageNo, frameNo);
+	}
+	if (resident) {
+		BufDesc &desc = bufDescTable[frameNo];
+		std::lock_guard<SpinLatch> guard(desc.latch);
+		// the frame may have been evicted before we got its latch
+		if (desc.valid && desc.file == file && desc.pageNo == PageNo) {
+			if (desc.pinCnt > 0)
+				throw PagePinnedException(file->filename(), PageNo, frameNo);
+			if (dropFrame(frameNo, false)) {
+				std::lock_guard<SpinLatch> freeGuard(freeLatch);
+				freeFrames.push_back(frameNo);
+			}
+		}
 	}
 	file->deletePage(PageNo);
 }
 
+BufAccessStrategy::BufAccessStrategy(const std::uint32_t ringSize)
+	: ring(std::max<std::uint32_t>(ringSize, 1)), current(0), reused(0)
+{
+	for (std::size_t i = 0; i < ring.size(); i++)
+		ring[i].file = NULL;
+}
+
+void BufAccessStrategy::remember(const FrameId frame, const File *file, const PageId pageNo)
+{
+	ring[current].frame = frame;
+	ring[current].file = file;
+	ring[current].pageNo = pageNo;
+}
+
+PageGuard::PageGuard()
+	: bufMgr(NULL), frameNo(0), pagePtr(NULL), mode(LATCH_NONE), dirty(false)
+{
+}
+
+PageGuard::PageGuard(BufMgr *bufMgr, FrameId frame, Page *page, LatchMode mode)
+	: bufMgr(bufMgr), frameNo(frame), pagePtr(page), mode(mode), dirty(false)
+{
+}
+
+PageGuard::PageGuard(PageGuard &&other)
+	: bufMgr(other.bufMgr), frameNo(other.frameNo), pagePtr(other.pagePtr), mode(other.mode), dirty(other.dirty)
+{
+	other.pagePtr = NULL;
+}
+
+PageGuard &PageGuard::operator=(PageGuard &&other)
+{
+	if (this != &other) {
+		release();
+		bufMgr = other.bufMgr;
+		frameNo = other.frameNo;
+		pagePtr = other.pagePtr;
+		mode = other.mode;
+		dirty = other.dirty;
+		other.pagePtr = NULL;
+	}
+	return *this;
+}
+
+PageGuard::~PageGuard()
+{
+	release();
+}
+
+void PageGuard::release()
+{
+	if (pagePtr == NULL)
+		return;
+	bufMgr->unpinFrame(frameNo, dirty, mode);
+	pagePtr = NULL;
+	dirty = false;
+}
+
 void BufMgr::printSelf(void)
 {
 	BufDesc *tmpbuf;
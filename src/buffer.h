@@ -1,290 +1,1180 @@
-/**
- * @author See Contributors.txt for code contributors and overview of BadgerDB.
- *
- * @section LICENSE
- * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
- */
-
-#pragma once
-
-#include "file.h"
-#include "bufHashTbl.h"
-
-namespace badgerdb {
-
-/**
-* forward declaration of BufMgr class 
-*/
-class BufMgr;
-
-/**
-* @brief Class for maintaining information about buffer pool frames
-*/
-class BufDesc {
-
-	friend class BufMgr;
-
- private:
-	/**
-   * Pointer to file to which corresponding frame is assigned
-	 */
-  File* file;
-
-	/**
-   * Page within file to which corresponding frame is assigned
-	 */
-  PageId pageNo;
-
-	/**
-   * Frame number of the frame, in the buffer pool, being used
-	 */
-  FrameId	frameNo;
-
-	/**
-   * Number of times this page has been pinned
-	 */
-  int pinCnt;
-
-	/**
-   * True if page is dirty;  false otherwise
-	 */
-  bool dirty;
-
-	/**
-   * True if page is valid
-	 */
-  bool valid;
-
-	/**
-   * Has this buffer frame been reference recently
-	 */
-  bool refbit;
-
-	/**
-   * Initialize buffer frame for a new user
-	 */
-  void Clear()
-	{
-    pinCnt = 0;
-		file = NULL;
-		pageNo = Page::INVALID_NUMBER;
-    dirty = false;
-    refbit = false;
-		valid = false;
-  };
-
-	/**
-	 * Set values of member variables corresponding to assignment of frame to a page in the file. Called when a frame 
-	 * in buffer pool is allocated to any page in the file through readPage() or allocPage()
-	 *
-	 * @param filePtr	File object
-	 * @param pageNum	Page number in the file
-	 */
-  void Set(File* filePtr, PageId pageNum)
-	{ 
-		file = filePtr;
-    pageNo = pageNum;
-    pinCnt = 1;
-    dirty = false;
-    valid = true;
-    refbit = true;
-  }
-
-  void Print()
-	{
-		if(file)
-		{
-			std::cout << "file:" << file->filename() << " ";
-			std::cout << "pageNo:" << pageNo << " ";
-		}
-		else
-			std::cout << "file:NULL ";
-
-		std::cout << "valid:" << valid << " ";
-		std::cout << "pinCnt:" << pinCnt << " ";
-		std::cout << "dirty:" << dirty << " ";
-		std::cout << "refbit:" << refbit << "\n";
-  }
-
-	/**
-   * Constructor of BufDesc class 
-	 */
-  BufDesc()
-	{
-  	Clear();
-  }
-};
-
-
-/**
-* @brief Class to maintain statistics of buffer usage 
-*/
-struct BufStats
-{
-	/**
-   * Total number of accesses to buffer pool
-	 */
-  int accesses;
-
-	/**
-   * Number of pages read from disk (including allocs)
-	 */
-  int diskreads;
-
-	/**
-   * Number of pages written back to disk
-	 */
-  int diskwrites;
-
-	/**
-   * Clear all values 
-	 */
-  void clear()
-  {
-		accesses = diskreads = diskwrites = 0;
-  }
-      
-	/**
-   * Constructor of BufStats class 
-	 */
-  BufStats()
-  {
-		clear();
-  }
-};
-
-
-/**
-* @brief The central class which manages the buffer pool including frame allocation and deallocation to pages in the file 
-*/
-class BufMgr 
-{
- private:
-	/**
-   * Current position of clockhand in our buffer pool
-	 */
-  FrameId clockHand;
-
-	/**
-   * Number of frames in the buffer pool
-	 */
-  std::uint32_t numBufs;
-	
-	/**
-   * Hash table mapping (File, page) to frame
-	 */
-  BufHashTbl *hashTable;
-
-	/**
-   * Array of BufDesc objects to hold information corresponding to every frame allocation from 'bufPool' (the buffer pool)
-	 */
-  BufDesc *bufDescTable;
-
-	/**
-   * Maintains Buffer pool usage statistics 
-	 */
-  BufStats bufStats;
-
-	/**
-   * Advance clock to next frame in the buffer pool
-	 */
-  void advanceClock();
-
-	/**
-	 * Allocate a free frame.  
-	 *
-	 * @param frame   	Frame reference, frame ID of allocated frame returned via this variable
-	 * @throws BufferExceededException If no such buffer is found which can be allocated
-	 */
-  void allocBuf(FrameId & frame);
-
- public:
-	/**
-   * Actual buffer pool from which frames are allocated
-	 */
-  Page* bufPool;
-
-	/**
-   * Constructor of BufMgr class
-	 */
-  BufMgr(std::uint32_t bufs);
-	
-	/**
-   * Destructor of BufMgr class
-	 */
-  ~BufMgr();
-
-	/**
-	 * Reads the given page from the file into a frame and returns the pointer to page.
-	 * If the requested page is already present in the buffer pool pointer to that frame is returned
-	 * otherwise a new frame is allocated from the buffer pool for reading the page.
-	 *
-	 * @param file   	File object
-	 * @param PageNo  Page number in the file to be read
-	 * @param page  	Reference to page pointer. Used to fetch the Page object in which requested page from file is read in.
-	 */
-  void readPage(File* file, const PageId PageNo, Page*& page);
-
-	/**
-	 * Unpin a page from memory since it is no longer required for it to remain in memory.
-	 *
-	 * @param file   	File object
-	 * @param PageNo  Page number
-	 * @param dirty		True if the page to be unpinned needs to be marked dirty	
-   * @throws  PageNotPinnedException If the page is not already pinned
-	 */
-  void unPinPage(File* file, const PageId PageNo, const bool dirty);
-
-	/**
-	 * Allocates a new, empty page in the file and returns the Page object.
-	 * The newly allocated page is also assigned a frame in the buffer pool.
-	 *
-	 * @param file   	File object
-	 * @param PageNo  Page number. The number assigned to the page in the file is returned via this reference.
-	 * @param page  	Reference to page pointer. The newly allocated in-memory Page object is returned via this reference.
-	 */
-  void allocPage(File* file, PageId &PageNo, Page*& page); 
-
-	/**
-	 * Writes out all dirty pages of the file to disk.
-	 * All the frames assigned to the file need to be unpinned from buffer pool before this function can be successfully called.
-	 * Otherwise Error returned.
-	 *
-	 * @param file   	File object
-   * @throws  PagePinnedException If any page of the file is pinned in the buffer pool 
-   * @throws BadBufferException If any frame allocated to the file is found to be invalid
-	 */
-  void flushFile(const File* file);
-
-	/**
-	 * Delete page from file and also from buffer pool if present.
-	 * Since the page is entirely deleted from file, its unnecessary to see if the page is dirty.
-	 *
-	 * @param file   	File object
-	 * @param PageNo  Page number
-	 */
-  void disposePage(File* file, const PageId PageNo);
-
-	/**
-   * Print member variable values. 
-	 */
-  void  printSelf();
-
-	/**
-   * Get buffer pool usage statistics
-	 */
-  BufStats & getBufStats()
-  {
-		return bufStats;
-  }
-
-	/**
-   * Clear buffer pool usage statistics
-	 */
-  void clearBufStats() 
-  {
-		bufStats.clear();
-  }
-};
-
-}
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "file.h"
+#include "bufHashTbl.h"
+#include "latch.h"
+
+namespace badgerdb {
+
+/**
+* @brief Kinds of hash table the buffer manager can use to map (file, page) to frame
+*/
+enum HashTableType {
+	/**
+	 * Chained hash table of individually allocated buckets (BufHashTbl)
+	 */
+	CHAINED_HASH_TABLE,
+
+	/**
+	 * Open addressing hash table with entries stored inline (FlatBufHashTbl)
+	 */
+	FLAT_HASH_TABLE
+};
+
+/**
+* @brief Algorithms the buffer manager can use to choose which page to replace
+*/
+enum ReplacementPolicyType {
+	/**
+	 * Clock over the frames' reference bits (ClockPolicy)
+	 */
+	CLOCK_POLICY,
+
+	/**
+	 * LRU-K with K = 2 (LruKPolicy)
+	 */
+	LRU_K_POLICY,
+
+	/**
+	 * 2Q with a ghost queue (TwoQPolicy)
+	 */
+	TWO_Q_POLICY,
+
+	/**
+	 * Adaptive replacement cache (ArcPolicy)
+	 */
+	ARC_POLICY,
+
+	/**
+	 * CLOCK-Pro with hot, cold and non-resident test pages (ClockProPolicy)
+	 */
+	CLOCK_PRO_POLICY
+};
+
+/**
+* @brief How a file's pages are going to be read, used to decide how far ahead to read
+*/
+enum AccessPattern {
+	/**
+	 * Read ahead once misses on the file are seen to come in page order
+	 */
+	ACCESS_NORMAL,
+
+	/**
+	 * Read as far ahead as allowed on every miss
+	 */
+	ACCESS_SEQUENTIAL,
+
+	/**
+	 * Never read ahead
+	 */
+	ACCESS_RANDOM
+};
+
+/**
+* forward declaration of BufMgr class 
+*/
+class BufMgr;
+
+/**
+* forward declaration of ReplacementPolicy class 
+*/
+class ReplacementPolicy;
+
+/**
+* @brief Class for maintaining information about buffer pool frames
+*
+* The pin count, dirty, valid and reference bits are atomic so that threads
+* holding or looking up the page can update them without a latch.  The
+* assignment of the frame to a page (file, pageNo, valid) only changes while
+* the descriptor latch is held by a thread that owns the frame exclusively.
+*/
+class BufDesc {
+
+	friend class BufMgr;
+	friend class ReplacementPolicy;
+
+ private:
+	/**
+   * Pointer to file to which corresponding frame is assigned
+	 */
+  File* file;
+
+	/**
+   * Page within file to which corresponding frame is assigned
+	 */
+  PageId pageNo;
+
+	/**
+   * Frame number of the frame, in the buffer pool, being used
+	 */
+  FrameId	frameNo;
+
+	/**
+   * Number of times this page has been pinned
+	 */
+  std::atomic<int> pinCnt;
+
+	/**
+   * True if page is dirty;  false otherwise
+	 */
+  std::atomic<bool> dirty;
+
+	/**
+   * True if page is valid
+	 */
+  std::atomic<bool> valid;
+
+	/**
+   * Has this buffer frame been reference recently
+	 */
+  std::atomic<bool> refbit;
+
+	/**
+   * True while the page is being read into the frame.  The reading thread
+   * holds the page latch exclusively, so threads that find the page wait on it.
+	 */
+  std::atomic<bool> ioPending;
+
+	/**
+   * Set when reading the page into the frame failed, after the page was taken out of the hash table
+	 */
+  std::atomic<bool> readFailed;
+
+	/**
+   * True if the page was read ahead and has not been pinned since
+	 */
+  std::atomic<bool> prefetched;
+
+	/**
+   * Held while the frame is being evicted, flushed or assigned to a page
+	 */
+  SpinLatch latch;
+
+	/**
+   * Coordinates the threads reading and changing the page held in the frame
+	 */
+  SharedLatch pageLatch;
+
+	/**
+   * Frame number used to mark the end of a list of frames
+	 */
+  static const FrameId INVALID_FRAME = 0xFFFFFFFF;
+
+	/**
+   * Next frame holding a page of the same file, INVALID_FRAME if there is none
+	 */
+  FrameId nextInFile;
+
+	/**
+   * Previous frame holding a page of the same file, INVALID_FRAME if there is none
+	 */
+  FrameId prevInFile;
+
+	/**
+   * Initialize buffer frame for a new user
+	 */
+  void Clear()
+	{
+    pinCnt = 0;
+		file = NULL;
+		pageNo = Page::INVALID_NUMBER;
+    dirty = false;
+    refbit = false;
+		valid = false;
+		ioPending = false;
+		readFailed = false;
+		prefetched = false;
+		nextInFile = INVALID_FRAME;
+		prevInFile = INVALID_FRAME;
+  };
+
+	/**
+	 * Set values of member variables corresponding to assignment of frame to a page in the file. Called when a frame 
+	 * in buffer pool is allocated to any page in the file through readPage() or allocPage()
+	 *
+	 * @param filePtr	File object
+	 * @param pageNum	Page number in the file
+	 */
+  void Set(File* filePtr, PageId pageNum)
+	{ 
+		file = filePtr;
+    pageNo = pageNum;
+    pinCnt = 1;
+    dirty = false;
+    valid = true;
+    refbit = true;
+  }
+
+  void Print()
+	{
+		if(file)
+		{
+			std::cout << "file:" << file->filename() << " ";
+			std::cout << "pageNo:" << pageNo << " ";
+		}
+		else
+			std::cout << "file:NULL ";
+
+		std::cout << "valid:" << valid << " ";
+		std::cout << "pinCnt:" << pinCnt << " ";
+		std::cout << "dirty:" << dirty << " ";
+		std::cout << "refbit:" << refbit << "\n";
+  }
+
+	/**
+   * Constructor of BufDesc class 
+	 */
+  BufDesc()
+	{
+  	Clear();
+  }
+};
+
+
+/**
+* @brief Class to maintain statistics of buffer usage 
+*/
+struct BufStats
+{
+	/**
+   * Total number of accesses to buffer pool
+	 */
+  std::atomic<int> accesses;
+
+	/**
+   * Number of pages read from disk (including allocs)
+	 */
+  std::atomic<int> diskreads;
+
+	/**
+   * Number of pages written back to disk
+	 */
+  std::atomic<int> diskwrites;
+
+	/**
+   * Number of pages written back by the background writer
+	 */
+  std::atomic<int> bgwrites;
+
+	/**
+   * Number of pages written back by a thread that needed their frame for another page
+	 */
+  std::atomic<int> fgwrites;
+
+	/**
+   * Number of pages read ahead of a sequential reader or by prefetch()
+	 */
+  std::atomic<int> prefetched;
+
+	/**
+   * Number of pages read ahead that were pinned before leaving the buffer pool
+	 */
+  std::atomic<int> prefetchHits;
+
+	/**
+   * Number of pages read ahead that left the buffer pool without being pinned
+	 */
+  std::atomic<int> prefetchWasted;
+
+	/**
+   * Clear all values 
+	 */
+  void clear()
+  {
+		accesses = diskreads = diskwrites = 0;
+		bgwrites = fgwrites = 0;
+		prefetched = prefetchHits = prefetchWasted = 0;
+  }
+      
+	/**
+   * Constructor of BufStats class 
+	 */
+  BufStats()
+  {
+		clear();
+  }
+};
+
+
+/**
+* @brief One partition of the hash table mapping (File, page) to frame, with the latch protecting it
+*/
+struct BufHashShard
+{
+	/**
+   * Held while the table is read or changed, and while a frame found in it is pinned
+	 */
+  std::mutex latch;
+
+	/**
+   * Hash table for the pages that fall into this partition
+	 */
+  BufHashIndex *table;
+};
+
+
+/**
+* @brief Settings of the background writer
+*/
+struct BgWriterConfig
+{
+	/**
+   * Number of clean, unpinned frames the writer tries to keep among the next victims of the replacement policy
+	 */
+  std::uint32_t cleanTarget;
+
+	/**
+   * Most pages written in one round
+	 */
+  std::uint32_t maxPagesPerRound;
+
+	/**
+   * Time between rounds, in milliseconds
+	 */
+  std::uint32_t roundMs;
+
+	/**
+   * Constructor of BgWriterConfig class
+	 */
+  BgWriterConfig(std::uint32_t target = 64, std::uint32_t maxPages = 100, std::uint32_t delayMs = 200)
+		: cleanTarget(target), maxPagesPerRound(maxPages), roundMs(delayMs)
+  {
+  }
+};
+
+
+/**
+* @brief How far ahead the pages of a file are read
+*/
+struct ReadAheadState
+{
+	/**
+   * Access pattern the file was advised to follow
+	 */
+  AccessPattern pattern;
+
+	/**
+   * Page that continues the run of misses in page order, if the next miss is on it
+	 */
+  PageId nextPage;
+
+	/**
+   * Number of pages read ahead on the last miss of the run, 0 if there is no run
+	 */
+  PageId window;
+
+	/**
+   * Constructor of ReadAheadState class
+	 */
+  ReadAheadState()
+		: pattern(ACCESS_NORMAL), nextPage(Page::INVALID_NUMBER), window(0)
+  {
+  }
+};
+
+
+/**
+* @brief Pin on a page in the buffer pool that is released when the guard goes out of scope
+*
+* A guard remembers the frame holding the page, so unpinning it does not have
+* to look the page up in the hash table again, and a pin is never leaked when
+* an exception unwinds past the code using the page.  Guards can be moved but
+* not copied; a guard that was moved from, or released, holds no page.
+*/
+class PageGuard
+{
+	friend class BufMgr;
+
+ public:
+	/**
+   * Constructs a guard that holds no page
+	 */
+  PageGuard();
+
+	/**
+   * Takes over the page held by another guard
+	 */
+  PageGuard(PageGuard&& other);
+
+	/**
+   * Releases the page held by this guard and takes over the page held by another guard
+	 */
+  PageGuard& operator=(PageGuard&& other);
+
+	/**
+   * Unpins the page, if the guard holds one
+	 */
+  ~PageGuard();
+
+	/**
+   * Returns the page, or NULL if the guard holds no page
+	 */
+  Page* page() const
+  {
+		return pagePtr;
+  }
+
+  Page* operator->() const
+  {
+		return pagePtr;
+  }
+
+  Page& operator*() const
+  {
+		return *pagePtr;
+  }
+
+	/**
+   * Returns true if the guard holds a page
+	 */
+  bool holdsPage() const
+  {
+		return pagePtr != NULL;
+  }
+
+	/**
+   * Marks the page dirty, so it is written back before its frame is reused
+	 */
+  void markDirty()
+  {
+		dirty = true;
+  }
+
+	/**
+	 * Unpins the page now rather than when the guard is destroyed.
+	 */
+  void release();
+
+ private:
+  PageGuard(BufMgr* bufMgr, FrameId frame, Page* page, LatchMode mode);
+  PageGuard(const PageGuard&);
+  PageGuard& operator=(const PageGuard&);
+
+	/**
+   * Buffer manager the page is pinned in
+	 */
+  BufMgr* bufMgr;
+
+	/**
+   * Frame holding the page
+	 */
+  FrameId frameNo;
+
+	/**
+   * The pinned page, NULL if the guard holds no page
+	 */
+  Page* pagePtr;
+
+	/**
+   * Latch mode the page was pinned with
+	 */
+  LatchMode mode;
+
+	/**
+   * True if the page is to be unpinned dirty
+	 */
+  bool dirty;
+};
+
+
+/**
+* @brief Ring of frames a bulk scan or load recycles instead of competing for the whole buffer pool
+*
+* Pass a strategy to readPage() or allocPage() and each page they have to
+* bring in goes into the frame the same strategy used one lap of the ring
+* ago, provided that frame still holds the page it was given and nobody has
+* it pinned.  Until the ring is full, and whenever its frame cannot be
+* reused, a frame is allocated as usual and takes that place in the ring.  A
+* scan of any length therefore replaces at most about as many pages as the
+* ring has frames, and the rest of the pool keeps its working set.  Pages
+* already in the buffer pool are read from where they are.
+*
+* The ring never holds more than an eighth of the pool.  A strategy belongs to
+* one scan and must not be used by two threads at the same time.
+*/
+class BufAccessStrategy
+{
+	friend class BufMgr;
+
+ public:
+	/**
+   * Ring size for scans that only read, 256 KB of pages
+	 */
+  static const std::uint32_t BULK_READ_RING = 32;
+
+	/**
+   * Ring size for bulk loads, large enough that writing back a frame before
+   * reusing it is rarely waited on
+	 */
+  static const std::uint32_t BULK_WRITE_RING = 256;
+
+	/**
+   * Constructor of BufAccessStrategy class
+	 *
+	 * @param ringSize Number of frames in the ring
+	 */
+  explicit BufAccessStrategy(const std::uint32_t ringSize = BULK_READ_RING);
+
+	/**
+   * Number of pages brought into a frame taken back from the ring
+	 */
+  std::uint64_t reusedFrames() const
+  {
+		return reused;
+  }
+
+ private:
+	/**
+   * Frame of the ring and the page it was given
+	 */
+  struct RingSlot {
+    FrameId frame;
+    const File* file;
+    PageId pageNo;
+  };
+
+	/**
+   * Frames in the order they are reused; a slot with no file holds no frame yet
+	 */
+  std::vector<RingSlot> ring;
+
+	/**
+   * Slot of the frame used last
+	 */
+  std::uint32_t current;
+
+	/**
+   * Number of pages brought into a frame taken back from the ring
+	 */
+  std::uint64_t reused;
+
+	/**
+   * Puts a frame that was just given a page into the current slot of the ring.
+	 */
+  void remember(const FrameId frame, const File* file, const PageId pageNo);
+};
+
+
+/**
+* @brief The central class which manages the buffer pool including frame allocation and deallocation to pages in the file 
+*
+* All public methods may be called concurrently.  The hash table is split
+* into independently latched shards and pin counts and reference bits are
+* updated atomically, so threads working on different pages rarely wait for
+* each other.  Which page to replace is left to a ReplacementPolicy chosen
+* when the buffer manager is constructed.  Latches are always acquired in the order frame descriptor, hash
+* shard, and then the file list or free list latch.
+*
+* Pinning a page on its own does not stop other threads that have pinned it
+* too from reading or changing it at the same time.  Threads that share pages
+* read them with LATCH_SHARED or LATCH_EXCLUSIVE, which also keeps dirty pages
+* from being written back while they are being changed.
+*/
+class BufMgr 
+{
+	friend class PageGuard;
+
+ private:
+	/**
+   * Chooses the pages to replace
+	 */
+  ReplacementPolicy *policy;
+
+	/**
+   * Number of frames in the buffer pool
+	 */
+  std::uint32_t numBufs;
+	
+	/**
+   * Number of hash table shards, always a power of two
+	 */
+  std::uint32_t numShards;
+
+	/**
+   * Partitions of the hash table mapping (File, page) to frame
+	 */
+  BufHashShard *hashShards;
+
+	/**
+   * Array of BufDesc objects to hold information corresponding to every frame allocation from 'bufPool' (the buffer pool)
+	 */
+  BufDesc *bufDescTable;
+
+	/**
+   * Frames that hold no page, used as a stack so allocation takes constant time
+	 */
+  std::vector<FrameId> freeFrames;
+
+	/**
+   * Protects freeFrames
+	 */
+  SpinLatch freeLatch;
+
+	/**
+   * Number of frames whose pin count is zero, including free frames
+	 */
+  std::atomic<std::uint32_t> unpinnedFrames;
+
+	/**
+   * First frame of the list of frames holding pages of each file that has pages in the buffer pool
+	 */
+  std::map<const File*, FrameId> fileFrames;
+
+	/**
+   * Protects fileFrames and the nextInFile/prevInFile links of all frames
+	 */
+  std::mutex fileLatch;
+
+	/**
+   * Read-ahead state of each file that was advised or missed on
+	 */
+  std::map<const File*, ReadAheadState> readAheadFiles;
+
+	/**
+   * Protects readAheadFiles
+	 */
+  std::mutex readAheadLatch;
+
+	/**
+   * Background writer thread, not joinable when it is not running
+	 */
+  std::thread bgWriter;
+
+	/**
+   * Protects bgWriterConfig and bgWriterStop, and is what the background writer sleeps on between rounds
+	 */
+  std::mutex bgWriterLatch;
+
+	/**
+   * Wakes the background writer up to stop
+	 */
+  std::condition_variable bgWriterWake;
+
+	/**
+   * Set to make the background writer stop
+	 */
+  bool bgWriterStop;
+
+	/**
+   * Settings of the background writer
+	 */
+  BgWriterConfig bgWriterConfig;
+
+	/**
+   * Next frame the background writer looks at, if the replacement policy does not say
+	 */
+  FrameId bgWriterHand;
+
+	/**
+   * Maintains Buffer pool usage statistics 
+	 */
+  BufStats bufStats;
+
+	/**
+	 * Returns the hash table shard responsible for (file, pageNo).
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 */
+  BufHashShard &shardFor(const File* file, const PageId pageNo);
+
+	/**
+	 * Pins the page, reading it into a frame first if it is not in the buffer pool, and latches it.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file to be read
+	 * @param mode  	How the page is latched once it is pinned
+	 * @param strategy Ring the page is read into if it is not in the buffer pool, or NULL
+	 * @return  			Frame holding the page
+	 */
+  FrameId fetchFrame(File* file, const PageId pageNo, const LatchMode mode, BufAccessStrategy* strategy);
+
+	/**
+	 * Pins a batch of pages of the file.  The pages that are not in the buffer
+	 * pool are read in page number order, with one read for each run of
+	 * consecutive page numbers within a bitmap group (see File::groupEnd()).
+	 *
+	 * @param file   	File object
+	 * @param pageNos Pages to pin, in any order; a page may appear more than once and is then pinned as often
+	 * @param frames  Set to the frame holding each page, or BufDesc::INVALID_FRAME for
+	 *                pages that are not in the file and, when prefetching, pages that were skipped
+	 * @param prefetching If set, pages already in the buffer pool and pages no frame is
+	 *                left for are skipped, and pages read are counted as read ahead
+	 * @throws BufferExceededException If not prefetching and every frame is pinned
+	 */
+  void fetchFrames(File* file, const std::vector<PageId>& pageNos, std::vector<FrameId>& frames, const bool prefetching);
+
+	/**
+	 * Allocates a new page in the file and pins it in a frame.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  The number assigned to the page in the file is returned via this reference.
+	 * @param strategy Ring the page is put into, or NULL
+	 * @return  			Frame holding the page
+	 */
+  FrameId allocFrame(File* file, PageId &pageNo, BufAccessStrategy* strategy);
+
+	/**
+	 * Releases the latch and one pin on a frame the caller has pinned.
+	 *
+	 * @param frame   	Frame number of the frame
+	 * @param dirty		True if the page needs to be marked dirty
+	 * @param mode  	Latch mode the page was pinned with
+	 */
+  void unpinFrame(const FrameId frame, const bool dirty, const LatchMode mode);
+
+	/**
+	 * Pin a frame that was just found in the hash table.  Caller holds the latch of the frame's hash shard.
+	 *
+	 * @param frame   	Frame number of the frame
+	 */
+  void pinFrame(const FrameId frame);
+
+	/**
+	 * Take a frame off the free list, pinned once on behalf of the caller.
+	 *
+	 * @param frame   	Frame reference, frame ID of the frame returned via this variable
+	 * @return  			False if the free list is empty
+	 */
+  bool popFreeFrame(FrameId & frame);
+
+	/**
+	 * Remove the page held by an unpinned frame from the buffer pool, writing it
+	 * back first if it is dirty and writeBack is set, and clear the frame.  The
+	 * frame is left unpinned and off the free list.  Caller holds the frame's descriptor latch.
+	 *
+	 * @param frame   	Frame number of the frame
+	 * @param writeBack Whether dirty contents are written back or discarded
+	 * @return  			False, leaving the frame untouched, if it holds no page or
+	 *                is pinned, or if it is dirtied again while being written back
+	 */
+  bool dropFrame(const FrameId frame, const bool writeBack);
+
+	/**
+	 * Map (file, pageNo) to a frame returned by allocBuf() so the calling thread can read the page into it.
+	 * The frame is left with ioPending set and its page latch held exclusively until the caller, fetchFrame() or
+	 * fetchFrames(), has read the page into it and clears ioPending, or gives up on it with abandonRead().
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 * @param frame   	Frame returned by allocBuf()
+	 * @param existing Set to the frame of the page, pinned, if another thread mapped the page first
+	 * @return  			False if another thread mapped the page first
+	 */
+  bool claimPage(File* file, const PageId pageNo, const FrameId frame, FrameId & existing);
+
+	/**
+	 * Take a frame whose read failed out of the buffer pool.  Waits for the
+	 * threads that pinned it while the read was in progress to let go of it.
+	 *
+	 * @param frame   	Frame passed to claimPage()
+	 */
+  void abandonRead(const FrameId frame);
+
+	/**
+	 * Wait for the read of a page that was just pinned to finish, then latch the page.
+	 *
+	 * @param frame   	Frame holding the page
+	 * @param mode  	How the page is latched
+	 * @return  			False, with the pin released, if the read failed and the page has to be looked up again
+	 */
+  bool waitForRead(const FrameId frame, const LatchMode mode);
+
+	/**
+	 * Install a page that was just read into a frame returned by allocBuf(), unless another thread
+	 * installed the same page first, in which case that frame is pinned and ours is released.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 * @param frame   	Frame holding the page, set to the frame actually used
+	 */
+  void installPage(File* file, const PageId pageNo, FrameId & frame);
+
+	/**
+	 * Decide how many pages to read ahead of a page that missed, and note the miss.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number of the miss
+	 * @param strategy Ring the pages go into, or NULL
+	 * @return  			Number of pages following pageNo to read along with it
+	 */
+  PageId readAheadWindow(const File* file, const PageId pageNo, const BufAccessStrategy* strategy);
+
+	/**
+	 * Claim frames with claimPage() for the pages following a page that missed, before they are read
+	 * along with it.  Stops at the first page that is in the buffer pool or being read by another
+	 * thread, or once every frame is pinned.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number of the miss
+	 * @param window  Number of pages following pageNo to claim at most
+	 * @param strategy Ring the pages go into, or NULL
+	 * @param frames  Frames claimed for pageNo + 1, pageNo + 2, ... are appended to it
+	 */
+  void claimReadAhead(File* file, const PageId pageNo, const PageId window, BufAccessStrategy* strategy,
+											std::vector<FrameId>& frames);
+
+	/**
+	 * Complete the reads of pages read along with a page that missed into the frames claimReadAhead()
+	 * claimed for them, leaving them unpinned.  Frames of pages that turned out not to be used, or to
+	 * be past the end of the file, are given up with abandonRead().
+	 *
+	 * @param pageNo  Page number of the miss
+	 * @param pages  	Pages read, the first of which is the one that missed; they are moved into the frames
+	 * @param frames  Frames claimed for the pages following pageNo
+	 */
+  void installReadAhead(const PageId pageNo, std::vector<Page>& pages, const std::vector<FrameId>& frames);
+
+	/**
+	 * Read less far ahead in the file, one of whose pages was read ahead for nothing.
+	 *
+	 * @param file   	File object
+	 */
+  void shrinkReadAhead(const File* file);
+
+	/**
+	 * Body of the background writer thread: runs rounds of cleanAhead() until stopped.
+	 */
+  void runBgWriter();
+
+	/**
+	 * One round of the background writer.  Looks at the frames ahead of the
+	 * replacement policy, writing back the dirty ones it is likely to choose
+	 * next, until enough of them are clean or the round wrote as many pages as it may.
+	 *
+	 * @param config  Settings of the round
+	 * @return  			Number of pages written
+	 */
+  std::uint32_t cleanAhead(const BgWriterConfig &config);
+
+	/**
+	 * Write back the dirty pages of the file in page number order, so that
+	 * pages next to each other in the file go out in a single write, then sync
+	 * the file once.  Pages being changed under an exclusive latch are skipped
+	 * and stay dirty.  The pages written are pinned and latched shared until
+	 * they are on disk.
+	 *
+	 * @param file   	File object
+	 * @return  			Number of pages written
+	 */
+  std::uint32_t writeBackFile(const File* file);
+
+	/**
+	 * Remove all pages of the file from the buffer pool.
+	 *
+	 * @param file   	File object
+	 * @param writeBack Whether dirty pages are written back or discarded
+   * @throws  PagePinnedException If any page of the file is pinned in the buffer pool 
+   * @throws BadBufferException If any frame allocated to the file is found to be invalid
+	 */
+  void dropFile(const File* file, const bool writeBack);
+
+	/**
+	 * Allocate a free frame.  Frames that hold no page are handed out first in
+	 * constant time; otherwise ReplacementPolicy::pickVictim() names victims
+	 * until one turns out to be unpinned and can be dropped, giving up after
+	 * numBufs of them.  The returned frame holds no page and is already pinned
+	 * once on behalf of the caller, who is expected to Set() it.
+	 *
+	 * @param frame   	Frame reference, frame ID of allocated frame returned via this variable
+	 * @param strategy Ring to take the frame from, if any
+	 * @throws BufferExceededException If no such buffer is found which can be allocated
+	 */
+  void allocBuf(FrameId & frame, BufAccessStrategy* strategy);
+
+	/**
+	 * Take back the next frame of the ring, if it still holds the page the ring gave it and is unpinned.
+	 * The page is written back if it is dirty.  On success the frame holds no page and is pinned once.
+	 *
+	 * @param strategy Ring of the scan
+	 * @param frame   	Frame reference, frame ID of the frame returned via this variable
+	 * @return  			False if a frame has to be allocated as usual for this slot of the ring
+	 */
+  bool reuseRingFrame(BufAccessStrategy* strategy, FrameId & frame);
+
+	/**
+	 * Returns the number of frames the ring of a strategy may hold in this buffer pool.
+	 *
+	 * @param strategy Ring of the scan
+	 */
+  std::uint32_t ringSize(const BufAccessStrategy* strategy) const;
+
+	/**
+	 * Put a frame returned by allocBuf() that was never assigned a page back on the free list.
+	 *
+	 * @param frame   	Frame number of the frame to release
+	 */
+  void releaseBuf(const FrameId frame);
+
+	/**
+	 * Add a frame that was just assigned to a page to the list of frames of its file.
+	 *
+	 * @param frame   	Frame number of the frame
+	 */
+  void linkFileFrame(const FrameId frame);
+
+	/**
+	 * Remove a frame that is about to be cleared from the list of frames of its file.
+	 *
+	 * @param frame   	Frame number of the frame
+	 */
+  void unlinkFileFrame(const FrameId frame);
+
+	/**
+	 * Returns the first frame on the list of frames of the file.
+	 *
+	 * @param file   	File object
+	 * @return  			Frame number, BufDesc::INVALID_FRAME if the file has no pages in the buffer pool
+	 */
+  FrameId firstFileFrame(const File* file);
+
+	/**
+	 * Check that every frame assigned to the file can be removed from the buffer pool.
+	 *
+	 * @param file   	File object
+   * @throws  PagePinnedException If any page of the file is pinned in the buffer pool 
+   * @throws BadBufferException If any frame allocated to the file is found to be invalid
+	 */
+  void checkFileUnpinned(const File* file);
+
+ public:
+	/**
+   * Actual buffer pool from which frames are allocated
+	 */
+  Page* bufPool;
+
+	/**
+   * Constructor of BufMgr class
+	 *
+	 * @param bufs   	Number of frames in the buffer pool
+	 * @param tableType Kind of hash table used to map (file, page) to frame
+	 * @param shards 	Number of independently latched hash table partitions,
+	 *                rounded up to a power of two; use more on many-core machines
+	 * @param policyType Algorithm used to choose which page to replace
+	 */
+  BufMgr(std::uint32_t bufs, HashTableType tableType = CHAINED_HASH_TABLE,
+				 std::uint32_t shards = 1, ReplacementPolicyType policyType = CLOCK_POLICY);
+	
+	/**
+   * Destructor of BufMgr class
+	 */
+  ~BufMgr();
+
+	/**
+	 * Reads the given page from the file into a frame and returns the pointer to page.
+	 * If the requested page is already present in the buffer pool pointer to that frame is returned
+	 * otherwise a new frame is allocated from the buffer pool for reading the page.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number in the file to be read
+	 * @param page  	Reference to page pointer. Used to fetch the Page object in which requested page from file is read in.
+	 * @param mode  	How the page is latched once it is pinned; pass the same mode to unPinPage()
+	 * @param strategy Ring of frames to read the page into if it is not in the buffer pool; NULL competes for any frame
+	 */
+  void readPage(File* file, const PageId PageNo, Page*& page, const LatchMode mode = LATCH_NONE,
+								BufAccessStrategy* strategy = NULL);
+
+	/**
+	 * Reads a batch of pages, such as the result of an index probe, and pins
+	 * each of them like readPage().  Pages not in the buffer pool are read
+	 * sorted by page number, with one read for each run of consecutive pages,
+	 * instead of one read per page.  Each page is unpinned with unPinPage()
+	 * once for every time it appears in the batch.
+	 *
+	 * @param file   	File object
+	 * @param pageNos Page numbers to read, in any order
+	 * @param pages  	Set to the page read for each entry of pageNos
+   * @throws  InvalidPageException If a page is not in the file, in which case no page is left pinned
+   * @throws BufferExceededException If there are not enough unpinned frames for the batch
+	 */
+  void readPages(File* file, const std::vector<PageId>& pageNos, std::vector<Page*>& pages);
+
+	/**
+	 * Brings the pages into the buffer pool, without pinning them, so later
+	 * reads of them do not wait for the disk.  They are read like readPages()
+	 * reads them.  Pages that are not in the file are ignored, and no more
+	 * pages are read once every frame is pinned.
+	 *
+	 * @param file   	File object
+	 * @param pageNos Page numbers to bring in, in any order
+	 */
+  void prefetch(File* file, const std::vector<PageId>& pageNos);
+
+	/**
+	 * Starts an optimistic read of a page, waiting while a thread holds it
+	 * with LATCH_EXCLUSIVE.  The page must stay pinned, by this thread or
+	 * another, until validateOptimisticRead() has been called.  Nothing is
+	 * written to shared memory, so any number of threads can read a hot page
+	 * this way without slowing each other down.
+	 *
+	 * @param page  	Page returned by readPage() or allocPage()
+	 * @return  			Version to pass to validateOptimisticRead()
+	 */
+  std::uint32_t beginOptimisticRead(const Page* page) const;
+
+	/**
+	 * Checks whether anything read from the page since beginOptimisticRead()
+	 * can be used.  Only changes made under LATCH_EXCLUSIVE are detected.
+	 * What was read may be inconsistent until this returns true, so it must be
+	 * copied out and checked before it is acted on, and lookups on it may throw.
+	 *
+	 * @param page  	Page passed to beginOptimisticRead()
+	 * @param version Version returned by beginOptimisticRead()
+	 * @return  			False if a writer latched the page in the meantime, in which case the read is retried
+	 */
+  bool validateOptimisticRead(const Page* page, const std::uint32_t version) const;
+
+	/**
+	 * Unpin a page from memory since it is no longer required for it to remain in memory.
+	 * Does nothing if the page is not present in the buffer pool.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number
+	 * @param dirty		True if the page to be unpinned needs to be marked dirty	
+	 * @param mode  	Latch mode the page was read with, released along with the pin
+   * @throws  PageNotPinnedException If the page is not already pinned
+	 */
+  void unPinPage(File* file, const PageId PageNo, const bool dirty, const LatchMode mode = LATCH_NONE);
+
+	/**
+	 * Allocates a new, empty page in the file and returns the Page object.
+	 * The newly allocated page is also assigned a frame in the buffer pool.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number. The number assigned to the page in the file is returned via this reference.
+	 * @param page  	Reference to page pointer. The newly allocated in-memory Page object is returned via this reference.
+	 * @param strategy Ring of frames to put the page in; NULL competes for any frame
+	 */
+  void allocPage(File* file, PageId &PageNo, Page*& page, BufAccessStrategy* strategy = NULL); 
+
+	/**
+	 * Reads the given page like readPage(), returning a guard that unpins it.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number in the file to be read
+	 * @param mode  	How the page is latched while the guard holds it
+	 * @param strategy Ring of frames to read the page into, or NULL
+	 * @return  			Guard holding the pinned page
+	 */
+  PageGuard fetchPage(File* file, const PageId PageNo, const LatchMode mode = LATCH_NONE,
+											BufAccessStrategy* strategy = NULL);
+
+	/**
+	 * Allocates a new page like allocPage(), returning a guard that unpins it.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number. The number assigned to the page in the file is returned via this reference.
+	 * @param strategy Ring of frames to put the page in, or NULL
+	 * @return  			Guard holding the pinned page
+	 */
+  PageGuard newPage(File* file, PageId &PageNo, BufAccessStrategy* strategy = NULL);
+
+	/**
+	 * Tells the buffer manager how the file is going to be read.  Misses on a
+	 * file read in page order bring in the following pages with the same
+	 * read, and the number of pages read ahead doubles with every such miss.
+	 *
+	 * @param file   	File object
+	 * @param pattern How the pages of the file are going to be read
+	 */
+  void adviseAccess(const File* file, const AccessPattern pattern);
+
+	/**
+	 * Starts a thread that writes back dirty pages before they are chosen for
+	 * replacement, so that threads missing on a page rarely have to write one
+	 * out first.  If the writer is already running, the new settings apply
+	 * from its next round.  Not to be called concurrently with stopBgWriter().
+	 *
+	 * @param config  Settings of the writer
+	 */
+  void startBgWriter(const BgWriterConfig &config = BgWriterConfig());
+
+	/**
+	 * Stops the background writer, if it is running, and waits for it to finish its round.
+	 */
+  void stopBgWriter();
+
+	/**
+	 * Writes out all dirty pages of the file to disk, and waits until they are there.
+	 * All the frames assigned to the file need to be unpinned from buffer pool before this function can be successfully called.
+	 * Otherwise Error returned.
+	 *
+	 * @param file   	File object
+   * @throws  PagePinnedException If any page of the file is pinned in the buffer pool 
+   * @throws BadBufferException If any frame allocated to the file is found to be invalid
+	 */
+  void flushFile(const File* file);
+
+	/**
+	 * Writes out the dirty pages of the file, leaving them in the buffer pool, so
+	 * a checkpoint can run while the file is in use.  Pinned pages are written
+	 * too, under a shared latch; pages latched exclusively are being changed and
+	 * are skipped rather than waited for, and stay dirty.  The pages written are
+	 * on disk when this returns.
+	 *
+	 * @param file   	File object
+	 * @return  			Number of pages written
+	 * @throws FileIOException If the pages could not be written to disk; they stay dirty
+	 */
+  std::uint32_t flushDirty(const File* file);
+
+	/**
+	 * Removes all pages of the file from the buffer pool without writing them out,
+	 * discarding changes made to dirty pages. Useful when the file is about to be deleted.
+	 * All the frames assigned to the file need to be unpinned from buffer pool before this function can be successfully called.
+	 *
+	 * @param file   	File object
+   * @throws  PagePinnedException If any page of the file is pinned in the buffer pool 
+   * @throws BadBufferException If any frame allocated to the file is found to be invalid
+	 */
+  void evictFile(const File* file);
+
+	/**
+	 * Delete page from file and also from buffer pool if present.
+	 * Since the page is entirely deleted from file, its unnecessary to see if the page is dirty.
+	 *
+	 * @param file   	File object
+	 * @param PageNo  Page number
+   * @throws  PagePinnedException If the page is pinned in the buffer pool 
+	 */
+  void disposePage(File* file, const PageId PageNo);
+
+	/**
+   * Print member variable values. 
+	 */
+  void  printSelf();
+
+	/**
+   * Get buffer pool usage statistics
+	 */
+  BufStats & getBufStats()
+  {
+		return bufStats;
+  }
+
+	/**
+   * Clear buffer pool usage statistics
+	 */
+  void clearBufStats() 
+  {
+		bufStats.clear();
+  }
+};
+
+}
@@ -0,0 +1,67 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "clockPolicy.h"
+
+namespace badgerdb {
+
+ClockPolicy::ClockPolicy(BufDesc *descs, const std::uint32_t bufs)
+	: ReplacementPolicy(descs, bufs), clockHand(bufs - 1)
+{
+}
+
+FrameId ClockPolicy::advanceClock()
+{
+	// advances the clock hand through the indices of the buffer; threads
+	// sweeping at the same time each get a different frame
+	return (clockHand.fetch_add(1) + 1) % numBufs;
+}
+
+void ClockPolicy::pageLoaded(const FrameId frame, const std::uint64_t pageKey)
+{
+	// BufDesc::Set() already set the reference bit
+}
+
+void ClockPolicy::pagePinned(const FrameId frame)
+{
+	// BufMgr sets the reference bit on every pin
+}
+
+void ClockPolicy::pageRemoved(const FrameId frame)
+{
+}
+
+bool ClockPolicy::pickVictim(FrameId &frame)
+{
+	for (std::uint32_t ticks = 0; ticks < numBufs * 2; ticks++) {
+		FrameId candidate = advanceClock();
+
+		// clear refbits found that are set
+		if (testAndClearRefbit(candidate))
+			continue;
+
+		// found valid frame that is not pinned with refbit not set
+		if (isEvictable(candidate)) {
+			frame = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ClockPolicy::sweepPosition(FrameId &frame) const
+{
+	frame = (clockHand + 1) % numBufs;
+	return true;
+}
+
+bool ClockPolicy::likelyVictim(const FrameId frame) const
+{
+	return isEvictable(frame) && !isReferenced(frame);
+}
+
+}
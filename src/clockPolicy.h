@@ -0,0 +1,71 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "replacementPolicy.h"
+
+namespace badgerdb {
+
+/**
+* @brief Clock replacement, approximating LRU with the reference bit of each frame
+*
+* The hand sweeps over the frames, clearing reference bits that are set and
+* choosing the first unpinned frame whose bit is clear.  The hand is advanced
+* with an atomic increment and pins only set the frame's reference bit, so
+* this policy takes no latch.
+*/
+class ClockPolicy : public ReplacementPolicy
+{
+ private:
+	/**
+   * Current position of clockhand in our buffer pool
+	 */
+  std::atomic<FrameId> clockHand;
+
+	/**
+   * Advance clock to next frame in the buffer pool
+	 *
+	 * @return  			The frame the clock hand moved to
+	 */
+  FrameId advanceClock();
+
+ public:
+	/**
+   * Constructor of ClockPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  ClockPolicy(BufDesc *descs, const std::uint32_t bufs);
+
+  void pageLoaded(const FrameId frame, const std::uint64_t pageKey);
+
+  void pagePinned(const FrameId frame);
+
+  void pageRemoved(const FrameId frame);
+
+	/**
+   * Sweeps the clock at most twice around the buffer pool: once to clear
+   * reference bits, once to find a frame whose bit stayed clear.
+	 */
+  bool pickVictim(FrameId &frame);
+
+	/**
+   * The frame after the clock hand.
+	 */
+  bool sweepPosition(FrameId &frame) const;
+
+	/**
+   * Unpinned frames whose reference bit is clear are taken when the hand gets to them.
+	 */
+  bool likelyVictim(const FrameId frame) const;
+};
+
+}
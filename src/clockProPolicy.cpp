@@ -0,0 +1,233 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "clockProPolicy.h"
+
+namespace badgerdb {
+
+const int ClockProPolicy::NO_ENTRY;
+const FrameId ClockProPolicy::NOT_RESIDENT;
+
+ClockProPolicy::ClockProPolicy(BufDesc *descs, const std::uint32_t bufs)
+	: ReplacementPolicy(descs, bufs),
+		entries(2 * bufs + 1),
+		frameEntry(bufs, NO_ENTRY),
+		coldHand(NO_ENTRY),
+		hotHand(NO_ENTRY),
+		testHand(NO_ENTRY),
+		hotCount(0),
+		coldTarget(1)
+{
+	// at most one entry per frame, and as many non-resident ones
+	freeEntries.reserve(entries.size());
+	for (int i = entries.size(); i > 0; i--)
+		freeEntries.push_back(i - 1);
+}
+
+void ClockProPolicy::insertEntry(const int entry)
+{
+	ClockEntry &e = entries[entry];
+	if (hotHand == NO_ENTRY) {
+		e.prev = e.next = entry;
+		coldHand = hotHand = testHand = entry;
+		return;
+	}
+	// behind the hot hand is the position every hand reaches last
+	e.next = hotHand;
+	e.prev = entries[hotHand].prev;
+	entries[e.prev].next = entry;
+	entries[hotHand].prev = entry;
+}
+
+void ClockProPolicy::unlinkEntry(const int entry)
+{
+	ClockEntry &e = entries[entry];
+	if (e.next == entry) {
+		coldHand = hotHand = testHand = NO_ENTRY;
+		return;
+	}
+	if (coldHand == entry)
+		coldHand = e.next;
+	if (hotHand == entry)
+		hotHand = e.next;
+	if (testHand == entry)
+		testHand = e.next;
+	entries[e.prev].next = e.next;
+	entries[e.next].prev = e.prev;
+}
+
+void ClockProPolicy::removeEntry(const int entry)
+{
+	unlinkEntry(entry);
+	freeEntries.push_back(entry);
+}
+
+void ClockProPolicy::endTest(const int entry)
+{
+	ClockEntry &e = entries[entry];
+	e.inTest = false;
+	if (coldTarget > 1)
+		coldTarget--;
+	if (e.frame == NOT_RESIDENT) {
+		nonResident.erase(e.key);
+		removeEntry(entry);
+	}
+}
+
+void ClockProPolicy::balanceHot()
+{
+	// every hot page gets its reference bit cleared on the first pass, so two
+	// passes always find one to turn cold
+	std::uint32_t limit = 2 * (std::uint32_t)entries.size();
+	while (hotCount > 0 && hotCount + coldTarget > numBufs && limit-- > 0) {
+		int entry = hotHand;
+		ClockEntry &e = entries[entry];
+		hotHand = e.next;
+		if (e.hot) {
+			if (!testAndClearRefbit(e.frame)) {
+				e.hot = false;
+				hotCount--;
+			}
+		}
+		else if (e.inTest) {
+			// the hot hand passing a cold page means its test period is over
+			endTest(entry);
+		}
+	}
+}
+
+void ClockProPolicy::runTestHand()
+{
+	std::uint32_t limit = (std::uint32_t)entries.size();
+	while (testHand != NO_ENTRY && limit-- > 0) {
+		int entry = testHand;
+		ClockEntry &e = entries[entry];
+		testHand = e.next;
+		if (!e.hot && e.inTest) {
+			const bool resident = e.frame != NOT_RESIDENT;
+			endTest(entry);
+			if (!resident)
+				return;
+		}
+	}
+}
+
+void ClockProPolicy::pageLoaded(const FrameId frame, const std::uint64_t pageKey)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	// being read in is not a reference; only later hits count
+	testAndClearRefbit(frame);
+
+	int entry;
+	std::unordered_map<std::uint64_t, int>::iterator it = nonResident.find(pageKey);
+	if (it != nonResident.end()) {
+		// back during its test period: the page is hot, and cold pages need more room
+		entry = it->second;
+		nonResident.erase(it);
+		unlinkEntry(entry);
+		if (coldTarget < numBufs - 1)
+			coldTarget++;
+		entries[entry].hot = true;
+		entries[entry].inTest = false;
+		hotCount++;
+	}
+	else {
+		entry = freeEntries.back();
+		freeEntries.pop_back();
+		entries[entry].key = pageKey;
+		entries[entry].hot = false;
+		entries[entry].inTest = true;
+	}
+	entries[entry].frame = frame;
+	frameEntry[frame] = entry;
+	insertEntry(entry);
+	balanceHot();
+}
+
+void ClockProPolicy::pagePinned(const FrameId frame)
+{
+}
+
+void ClockProPolicy::pageRemoved(const FrameId frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	const int entry = frameEntry[frame];
+	frameEntry[frame] = NO_ENTRY;
+	if (entry == NO_ENTRY)
+		return;
+
+	ClockEntry &e = entries[entry];
+	e.frame = NOT_RESIDENT;
+	if (e.hot) {
+		hotCount--;
+		removeEntry(entry);
+		return;
+	}
+	if (!e.inTest) {
+		removeEntry(entry);
+		return;
+	}
+
+	// a cold page replaced during its test period is remembered
+	nonResident[e.key] = entry;
+	while (nonResident.size() > numBufs)
+		runTestHand();
+}
+
+bool ClockProPolicy::pickVictim(FrameId &frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	std::uint32_t limit = 2 * (std::uint32_t)entries.size();
+	while (coldHand != NO_ENTRY && limit-- > 0) {
+		int entry = coldHand;
+		ClockEntry &e = entries[entry];
+		if (e.hot || e.frame == NOT_RESIDENT || !isEvictable(e.frame)) {
+			coldHand = e.next;
+			continue;
+		}
+
+		coldHand = e.next;
+		if (!testAndClearRefbit(e.frame)) {
+			// an unreferenced cold page. Move past it anyway, so a caller that
+			// cannot take this frame is offered the next one.
+			frame = e.frame;
+			return true;
+		}
+
+		unlinkEntry(entry);
+		if (e.inTest) {
+			// referenced during its test period: the page is hot
+			e.hot = true;
+			e.inTest = false;
+			hotCount++;
+			if (coldTarget < numBufs - 1)
+				coldTarget++;
+		}
+		else {
+			// referenced again after its test period: start a new one
+			e.inTest = true;
+		}
+		insertEntry(entry);
+		balanceHot();
+	}
+
+	// every cold page is pinned; settle for any unpinned page
+	for (FrameId i = 0; i < numBufs; i++) {
+		if (frameEntry[i] != NO_ENTRY && isEvictable(i)) {
+			frame = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ClockProPolicy::likelyVictim(const FrameId frame) const
+{
+	return isEvictable(frame) && !isReferenced(frame);
+}
+
+}
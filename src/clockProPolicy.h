@@ -0,0 +1,168 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "replacementPolicy.h"
+
+namespace badgerdb {
+
+/**
+* @brief CLOCK-Pro replacement (Jiang, Chen and Zhang)
+*
+* Like clock, a hit only sets the frame's reference bit, so pinning a page
+* takes no latch.  Pages are hot or cold.  A page read in starts out cold and
+* in its test period; if it is referenced again before the test period ends
+* it becomes hot.  Only cold pages are replaced, and a cold page replaced
+* during its test period stays on the clock as a non-resident entry, so
+* coming back soon still makes it hot.  Three hands move over one circular
+* list: the cold hand chooses victims, the hot hand turns hot pages that
+* were not referenced cold, and the test hand ends the test periods of
+* non-resident pages when there are too many of them.  The number of frames
+* meant for cold pages grows whenever a page is referenced in its test
+* period and shrinks whenever a test period ends without a reference.
+*
+* A long scan therefore only cycles through the cold frames and the hot
+* working set stays resident.
+*/
+class ClockProPolicy : public ReplacementPolicy
+{
+ private:
+	/**
+   * Page on the clock, resident or not
+	 */
+  struct ClockEntry {
+    std::uint64_t key;
+    FrameId frame;
+    bool hot;
+    bool inTest;
+    int prev;
+    int next;
+  };
+
+	/**
+   * Marks the absence of an entry
+	 */
+  static const int NO_ENTRY = -1;
+
+	/**
+   * Frame of a page that is not in the buffer pool
+	 */
+  static const FrameId NOT_RESIDENT = 0xFFFFFFFF;
+
+	/**
+   * Protects all members below.  Only taken on misses, never on hits.
+	 */
+  std::mutex latch;
+
+	/**
+   * Storage for the entries of the clock
+	 */
+  std::vector<ClockEntry> entries;
+
+	/**
+   * Unused slots of entries
+	 */
+  std::vector<int> freeEntries;
+
+	/**
+   * Entry of the page held by each frame, NO_ENTRY if none
+	 */
+  std::vector<int> frameEntry;
+
+	/**
+   * Entries of non-resident pages in their test period, by page key
+	 */
+  std::unordered_map<std::uint64_t, int> nonResident;
+
+	/**
+   * Chooses the cold page to replace
+	 */
+  int coldHand;
+
+	/**
+   * Turns unreferenced hot pages cold; new entries go just behind it
+	 */
+  int hotHand;
+
+	/**
+   * Ends the test periods of non-resident pages
+	 */
+  int testHand;
+
+	/**
+   * Number of resident hot pages
+	 */
+  std::uint32_t hotCount;
+
+	/**
+   * Number of frames meant for cold pages
+	 */
+  std::uint32_t coldTarget;
+
+	/**
+   * Adds an entry for a resident page behind the hot hand.
+	 */
+  void insertEntry(const int entry);
+
+	/**
+   * Takes an entry off the clock, moving any hand on it to the next entry.
+	 */
+  void unlinkEntry(const int entry);
+
+	/**
+   * Takes an entry off the clock and frees it.
+	 */
+  void removeEntry(const int entry);
+
+	/**
+   * Ends the test period of a cold page that was not referenced during it.
+	 */
+  void endTest(const int entry);
+
+	/**
+   * Runs the hot hand until hot pages fit in the frames not meant for cold pages.
+	 */
+  void balanceHot();
+
+	/**
+   * Runs the test hand until it removed one non-resident page.
+	 */
+  void runTestHand();
+
+ public:
+	/**
+   * Constructor of ClockProPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  ClockProPolicy(BufDesc *descs, const std::uint32_t bufs);
+
+  void pageLoaded(const FrameId frame, const std::uint64_t pageKey);
+
+	/**
+   * Does nothing: BufMgr sets the reference bit of the frame.
+	 */
+  void pagePinned(const FrameId frame);
+
+  void pageRemoved(const FrameId frame);
+
+  bool pickVictim(FrameId &frame);
+
+	/**
+   * Unpinned frames whose reference bit is clear; whether they are cold is not
+   * checked, as that would take the latch.
+	 */
+  bool likelyVictim(const FrameId frame) const;
+};
+
+}
@@ -0,0 +1,59 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "badgerdb_exception.h"
+
+namespace badgerdb {
+
+/**
+ * @brief An exception that is thrown when the operating system fails to open,
+ *        read or write a file.
+ */
+class FileIOException : public BadgerDbException {
+ public:
+  /**
+   * Constructs a file I/O exception for the given file and error.
+   *
+   * @param name          Name of file the operation was on.
+   * @param error_number  Value of errno left by the failed call, or 0 if the
+   *                      file ended before the requested data.
+   */
+  FileIOException(const std::string& name, const int error_number);
+
+  /**
+   * Destroys the exception.  Does nothing special; just included to make the
+   * compiler happy.
+   */
+  virtual ~FileIOException() throw() {}
+
+  /**
+   * Returns the name of the file that caused this exception.
+   */
+  virtual const std::string& filename() const { return filename_; }
+
+  /**
+   * Returns the errno value of the failed call, or 0 for a short read.
+   */
+  virtual int error_number() const { return error_number_; }
+
+ protected:
+  /**
+   * Name of file that caused this exception.
+   */
+  const std::string filename_;
+
+  /**
+   * Errno value of the failed call.
+   */
+  const int error_number_;
+};
+
+}
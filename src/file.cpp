@@ -1,305 +1,697 @@
-/**
- * @author See Contributors.txt for code contributors and overview of BadgerDB.
- *
- * @section LICENSE
- * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
- */
-
-#include "file.h"
-
-#include <fstream>
-#include <iostream>
-#include <memory>
-#include <string>
-#include <cstdio>
-#include <cassert>
-
-#include "exceptions/file_exists_exception.h"
-#include "exceptions/file_not_found_exception.h"
-#include "exceptions/file_open_exception.h"
-#include "exceptions/invalid_page_exception.h"
-#include "file_iterator.h"
-#include "page.h"
-
-namespace badgerdb {
-
-File::StreamMap File::open_streams_;
-File::CountMap File::open_counts_;
-
-File File::create(const std::string& filename) {
-  return File(filename, true /* create_new */);
-}
-
-File File::open(const std::string& filename) {
-  return File(filename, false /* create_new */);
-}
-
-void File::remove(const std::string& filename) {
-  if (!exists(filename)) {
-    throw FileNotFoundException(filename);
-  }
-  if (isOpen(filename)) {
-    throw FileOpenException(filename);
-  }
-  std::remove(filename.c_str());
-}
-
-bool File::isOpen(const std::string& filename) {
-  if (!exists(filename)) {
-    return false;
-  }
-  return open_counts_.find(filename) != open_counts_.end();
-}
-
-bool File::exists(const std::string& filename) {
-	std::fstream file(filename);
-	if(file)
-	{
-		file.close();
-		return true;
-	}
-
-	return false;
-}
-
-File::File(const File& other)
-  : filename_(other.filename_),
-    stream_(open_streams_[filename_]) {
-  ++open_counts_[filename_];
-}
-
-File& File::operator=(const File& rhs) {
-  // This accounts for self-assignment and assignment of a File object for the
-  // same file.
-  close();	//close my file and associate me with the new one
-  filename_ = rhs.filename_;
-  openIfNeeded(false /* create_new */);
-  return *this;
-}
-
-File::~File() {
-  close();
-}
-
-Page File::allocatePage() {
-  FileHeader header = readHeader();
-  Page new_page;
-  Page existing_page;
-  if (header.num_free_pages > 0) {
-    new_page = readPage(header.first_free_page, true /* allow_free */);
-    new_page.set_page_number(header.first_free_page);
-    header.first_free_page = new_page.next_page_number();
-    --header.num_free_pages;
-
-    if (header.first_used_page == Page::INVALID_NUMBER ||
-        header.first_used_page > new_page.page_number()) {
-      // Either have no pages used or the head of the used list is a page later
-      // than the one we just allocated, so add the new page to the head.
-      if (header.first_used_page > new_page.page_number()) {
-        new_page.set_next_page_number(header.first_used_page);
-      }
-      header.first_used_page = new_page.page_number();
-    } else {
-      // New page is reused from somewhere after the beginning, so we need to
-      // find where in the used list to insert it.
-      PageId next_page_number = Page::INVALID_NUMBER;
-      for (FileIterator iter = begin(); iter != end(); ++iter) {
-        next_page_number = (*iter).next_page_number();
-        if (next_page_number > new_page.page_number() ||
-            next_page_number == Page::INVALID_NUMBER) {
-          existing_page = *iter;
-          break;
-        }
-      }
-      existing_page.set_next_page_number(new_page.page_number());
-      new_page.set_next_page_number(next_page_number);
-    }
-
-    assert((header.num_free_pages == 0) ==
-           (header.first_free_page == Page::INVALID_NUMBER));
-  } else {
-    new_page.set_page_number(header.num_pages);
-    if (header.first_used_page == Page::INVALID_NUMBER) {
-      header.first_used_page = new_page.page_number();
-    } else {
-      // If we have pages allocated, we need to add the new page to the tail
-      // of the linked list.
-      for (FileIterator iter = begin(); iter != end(); ++iter) {
-        if ((*iter).next_page_number() == Page::INVALID_NUMBER) {
-          existing_page = *iter;
-          break;
-        }
-      }
-      assert(existing_page.isUsed());
-      existing_page.set_next_page_number(new_page.page_number());
-    }
-    ++header.num_pages;
-  }
-  writePage(new_page.page_number(), new_page);
-  if (existing_page.page_number() != Page::INVALID_NUMBER) {
-    // If we updated an existing page by inserting the new page into the
-    // used list, we need to write it out.
-    writePage(existing_page.page_number(), existing_page);
-  }
-  writeHeader(header);
-
-  return new_page;
-}
-
-Page File::readPage(const PageId page_number) const {
-  FileHeader header = readHeader();
-  if (page_number >= header.num_pages) {
-    throw InvalidPageException(page_number, filename_);
-  }
-  return readPage(page_number, false /* allow_free */);
-}
-
-Page File::readPage(const PageId page_number, const bool allow_free) const {
-  Page page;
-  stream_->seekg(pagePosition(page_number), std::ios::beg);
-  stream_->read(reinterpret_cast<char*>(&page.header_), sizeof(page.header_));
-  stream_->read(reinterpret_cast<char*>(&page.data_[0]), Page::DATA_SIZE);
-  if (!allow_free && !page.isUsed()) {
-    throw InvalidPageException(page_number, filename_);
-  }
-
-  return page;
-}
-
-void File::writePage(const Page& new_page) {
-  PageHeader header = readPageHeader(new_page.page_number());
-  if (header.current_page_number == Page::INVALID_NUMBER) {
-    // Page has been deleted since it was read.
-    throw InvalidPageException(new_page.page_number(), filename_);
-  }
-  // Page on disk may have had its next page pointer updated since it was read;
-  // we don't modify that, but we do keep all the other modifications to the
-  // page header.
-  const PageId next_page_number = header.next_page_number;
-  header = new_page.header_;
-  header.next_page_number = next_page_number;
-  writePage(new_page.page_number(), header, new_page);
-}
-
-void File::deletePage(const PageId page_number) {
-  FileHeader header = readHeader();
-  Page existing_page = readPage(page_number);
-  Page previous_page;
-  // If this page is the head of the used list, update the header to point to
-  // the next page in line.
-  if (page_number == header.first_used_page) {
-    header.first_used_page = existing_page.next_page_number();
-  } else {
-    // Walk the used list so we can update the page that points to this one.
-    for (FileIterator iter = begin(); iter != end(); ++iter) {
-      previous_page = *iter;
-      if (previous_page.next_page_number() == existing_page.page_number()) {
-        previous_page.set_next_page_number(existing_page.next_page_number());
-        break;
-      }
-    }
-  }
-  // Clear the page and add it to the head of the free list.
-  existing_page.initialize();
-  existing_page.set_next_page_number(header.first_free_page);
-  header.first_free_page = page_number;
-  ++header.num_free_pages;
-  if (previous_page.isUsed()) {
-    writePage(previous_page.page_number(), previous_page);
-  }
-  writePage(page_number, existing_page);
-  writeHeader(header);
-}
-
-FileIterator File::begin() {
-  const FileHeader& header = readHeader();
-  return FileIterator(this, header.first_used_page);
-}
-
-FileIterator File::end() {
-  return FileIterator(this, Page::INVALID_NUMBER);
-}
-
-File::File(const std::string& name, const bool create_new) : filename_(name) {
-  openIfNeeded(create_new);
-
-  if (create_new) {
-    // File starts with 1 page (the header).
-    FileHeader header = {1 /* num_pages */, 0 /* first_used_page */,
-                         0 /* num_free_pages */, 0 /* first_free_page */};
-    writeHeader(header);
-  }
-}
-
-void File::openIfNeeded(const bool create_new) {
-  if (open_counts_.find(filename_) != open_counts_.end()) {	//exists an entry already
-    ++open_counts_[filename_];
-    stream_ = open_streams_[filename_];
-  } else {
-    std::ios_base::openmode mode =
-        std::fstream::in | std::fstream::out | std::fstream::binary;
-    const bool already_exists = exists(filename_);
-    if (create_new) {
-      // Error if we try to overwrite an existing file.
-      if (already_exists) {
-        throw FileExistsException(filename_);
-      }
-      // New files have to be truncated on open.
-      mode = mode | std::fstream::trunc;
-    } else {
-      // Error if we try to open a file that doesn't exist.
-      if (!already_exists) {
-        throw FileNotFoundException(filename_);
-      }
-    }
-    stream_.reset(new std::fstream(filename_, mode));
-    open_streams_[filename_] = stream_;
-    open_counts_[filename_] = 1;
-  }
-}
-
-void File::close() {
-  --open_counts_[filename_];
-  stream_.reset();
-  if (open_counts_[filename_] == 0) {
-    open_streams_.erase(filename_);
-    open_counts_.erase(filename_);
-  }
-}
-
-void File::writePage(const PageId page_number, const Page& new_page) {
-  writePage(page_number, new_page.header_, new_page);
-}
-
-void File::writePage(const PageId page_number, const PageHeader& header,
-                     const Page& new_page) {
-  stream_->seekp(pagePosition(page_number), std::ios::beg);
-  stream_->write(reinterpret_cast<const char*>(&header), sizeof(header));
-  stream_->write(reinterpret_cast<const char*>(&new_page.data_[0]),
-                 Page::DATA_SIZE);
-  stream_->flush();
-}
-
-FileHeader File::readHeader() const {
-  FileHeader header;
-  stream_->seekg(0 /* pos */, std::ios::beg);
-  stream_->read(reinterpret_cast<char*>(&header), sizeof(header));
-
-  return header;
-}
-
-void File::writeHeader(const FileHeader& header) {
-  stream_->seekp(0 /* pos */, std::ios::beg);
-  stream_->write(reinterpret_cast<const char*>(&header), sizeof(header));
-  stream_->flush();
-}
-
-PageHeader File::readPageHeader(PageId page_number) const {
-  PageHeader header;
-  stream_->seekg(pagePosition(page_number), std::ios::beg);
-  stream_->read(reinterpret_cast<char*>(&header), sizeof(header));
-
-  return header;
-}
-
-}
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <cstdio>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "exceptions/file_exists_exception.h"
+#include "exceptions/file_io_exception.h"
+#include "exceptions/file_not_found_exception.h"
+#include "exceptions/file_open_exception.h"
+#include "exceptions/invalid_page_exception.h"
+#include "file_iterator.h"
+#include "page.h"
+
+namespace badgerdb {
+
+namespace {
+
+/**
+ * Advances past the first done bytes of the buffers in parts, starting at
+ * parts[next], after a read or write that transferred only that many.
+ */
+void skipParts(std::vector<struct iovec>& parts, std::size_t& next,
+               std::size_t done) {
+  while (next < parts.size() && done >= parts[next].iov_len) {
+    done -= parts[next].iov_len;
+    ++next;
+  }
+  if (done > 0) {
+    parts[next].iov_base = static_cast<char*>(parts[next].iov_base) + done;
+    parts[next].iov_len -= done;
+  }
+}
+
+/**
+ * Describes the header and data of a page as two buffers, for vectored I/O
+ * straight to and from the page.
+ */
+void addPageParts(std::vector<struct iovec>& parts, const void* header,
+                  const void* data) {
+  struct iovec part;
+  part.iov_base = const_cast<void*>(header);
+  part.iov_len = sizeof(PageHeader);
+  parts.push_back(part);
+  part.iov_base = const_cast<void*>(data);
+  part.iov_len = Page::DATA_SIZE;
+  parts.push_back(part);
+}
+
+/**
+ * Reads size bytes at the given position of an open file into buffer.
+ */
+void readFully(const int fd, void* buffer, const std::size_t size,
+               const off_t position, const std::string& filename) {
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t result = ::pread(fd, static_cast<char*>(buffer) + done,
+                                   size - done, position + done);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      throw FileIOException(filename, result < 0 ? errno : 0);
+    }
+    done += result;
+  }
+}
+
+/**
+ * Writes size bytes from buffer at the given position of an open file.
+ */
+void writeFully(const int fd, const void* buffer, const std::size_t size,
+                const off_t position, const std::string& filename) {
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t result = ::pwrite(fd,
+                                    static_cast<const char*>(buffer) + done,
+                                    size - done, position + done);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result < 0) {
+      throw FileIOException(filename, errno);
+    }
+    done += result;
+  }
+}
+
+/**
+ * Preallocates length bytes at the given position of an open file, extending
+ * it, and returns true if it succeeded.  Uses fallocate() where available,
+ * then posix_fallocate(), and on file systems that support neither just sets
+ * the file size, which at least saves updating it on every page write.
+ */
+bool preallocate(const int fd, const off_t position, const off_t length) {
+#ifdef __linux__
+  if (::fallocate(fd, 0 /* mode */, position, length) == 0) {
+    return true;
+  }
+  if (errno != EOPNOTSUPP && errno != ENOSYS) {
+    return false;
+  }
+#endif
+  const int result = ::posix_fallocate(fd, position, length);
+  if (result == 0) {
+    return true;
+  }
+  if (result != EINVAL && result != EOPNOTSUPP) {
+    return false;
+  }
+  return ::ftruncate(fd, position + length) == 0;
+}
+
+/**
+ * Header of files in the format before the page directory, in which used
+ * and free pages were linked into lists through their headers and the pages
+ * followed the header with no bitmaps in between.
+ */
+struct LegacyFileHeader {
+  PageId num_pages;
+  PageId first_used_page;
+  PageId num_free_pages;
+  PageId first_free_page;
+};
+
+/**
+ * Number of bitmap words in one bitmap block.
+ */
+const std::size_t WORDS_PER_BITMAP = Page::SIZE / sizeof(std::uint64_t);
+
+/**
+ * Returns the number of bitmap blocks in a file of num_pages pages.
+ */
+std::size_t bitmapCount(const PageId num_pages) {
+  return (num_pages - 1 + File::PAGES_PER_BITMAP - 1) / File::PAGES_PER_BITMAP;
+}
+
+}
+
+const std::uint32_t File::FORMAT_MAGIC;
+const std::uint32_t File::FORMAT_VERSION;
+const PageId File::PAGES_PER_BITMAP;
+const PageId File::DEFAULT_EXTENT_PAGES;
+
+File::DescriptorMap File::open_descriptors_;
+File::LatchMap File::open_latches_;
+File::CountMap File::open_counts_;
+std::mutex File::open_files_latch_;
+std::atomic<std::uint32_t> File::next_id_(0);
+
+File File::create(const std::string& filename) {
+  return File(filename, true /* create_new */);
+}
+
+File File::open(const std::string& filename) {
+  return File(filename, false /* create_new */);
+}
+
+void File::remove(const std::string& filename) {
+  if (!exists(filename)) {
+    throw FileNotFoundException(filename);
+  }
+  if (isOpen(filename)) {
+    throw FileOpenException(filename);
+  }
+  std::remove(filename.c_str());
+}
+
+bool File::isOpen(const std::string& filename) {
+  if (!exists(filename)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> guard(open_files_latch_);
+  return open_counts_.find(filename) != open_counts_.end();
+}
+
+bool File::exists(const std::string& filename) {
+	std::fstream file(filename);
+	if(file)
+	{
+		file.close();
+		return true;
+	}
+
+	return false;
+}
+
+File::File(const File& other)
+  : filename_(other.filename_),
+    id_(next_id_++),
+    descriptor_(other.descriptor_),
+    latch_(other.latch_) {
+  std::lock_guard<std::mutex> guard(open_files_latch_);
+  ++open_counts_[filename_];
+}
+
+File& File::operator=(const File& rhs) {
+  // This accounts for self-assignment and assignment of a File object for the
+  // same file.
+  close();	//close my file and associate me with the new one
+  filename_ = rhs.filename_;
+  openIfNeeded(false /* create_new */);
+  return *this;
+}
+
+File::~File() {
+  close();
+}
+
+Page File::allocatePage() {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  FileHeader header = readHeader();
+  // Hand out the lowest free page, or grow the file if there is none.
+  const PageId page_number = nextFreePage(descriptor_->free_hint);
+  Page new_page;
+  new_page.set_page_number(page_number);
+  if (page_number == header.num_pages && reserveExtent(page_number)) {
+    // Space past the last page is only written by allocations, so the
+    // preallocated page already reads as zeros, like a new page's data.
+    writeAt(&new_page.header_, sizeof(PageHeader),
+            pagePosition(page_number));
+  } else {
+    writePage(page_number, new_page);
+  }
+  if (page_number == header.num_pages) {
+    ++header.num_pages;
+  }
+  setPageUsed(page_number, true);
+  descriptor_->free_hint = page_number + 1;
+  ++header.num_used_pages;
+  writeHeader(header);
+
+  return new_page;
+}
+
+Page File::readPage(const PageId page_number) const {
+  if (page_number == Page::INVALID_NUMBER ||
+      page_number >= descriptor_->num_pages) {
+    throw InvalidPageException(page_number, filename_);
+  }
+  return readPage(page_number, false /* allow_free */);
+}
+
+std::vector<Page> File::readPages(const PageId first_page_number,
+                                  const PageId count) const {
+  const PageId num_pages = descriptor_->num_pages;
+  if (first_page_number == Page::INVALID_NUMBER ||
+      first_page_number >= num_pages) {
+    throw InvalidPageException(first_page_number, filename_);
+  }
+  const PageId run = std::min(count, num_pages - first_page_number);
+
+  // Read the run straight into the pages with one vectored read per group.
+  std::vector<Page> pages(run);
+  std::vector<struct iovec> parts;
+  PageId first = 0;
+  while (first < run) {
+    const PageId last = std::min<PageId>(
+        run, groupEnd(first_page_number + first) - first_page_number);
+    parts.clear();
+    for (PageId i = first; i < last; ++i) {
+      addPageParts(parts, &pages[i].header_, &pages[i].data_[0]);
+    }
+    readPartsAt(parts, pagePosition(first_page_number + first));
+    first = last;
+  }
+
+  if (!pages.front().isUsed()) {
+    throw InvalidPageException(first_page_number, filename_);
+  }
+  pages.erase(std::remove_if(pages.begin(), pages.end(),
+                             [](const Page& page) { return !page.isUsed(); }),
+              pages.end());
+  return pages;
+}
+
+Page File::readPage(const PageId page_number, const bool allow_free) const {
+  Page page;
+  std::vector<struct iovec> parts;
+  addPageParts(parts, &page.header_, &page.data_[0]);
+  readPartsAt(parts, pagePosition(page_number));
+  if (!allow_free && !page.isUsed()) {
+    throw InvalidPageException(page_number, filename_);
+  }
+
+  return page;
+}
+
+void File::writePage(const Page& new_page) {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  if (!isPageUsed(new_page.page_number())) {
+    // Page has been deleted since it was read.
+    throw InvalidPageException(new_page.page_number(), filename_);
+  }
+  writePage(new_page.page_number(), new_page);
+}
+
+void File::writePages(const std::vector<const Page*>& pages) {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  std::vector<struct iovec> parts;
+  std::size_t first = 0;
+  while (first < pages.size()) {
+    const PageId first_page_number = pages[first]->page_number();
+    const PageId group_end = groupEnd(first_page_number);
+    std::size_t last = first + 1;
+    while (last < pages.size() &&
+           pages[last]->page_number() ==
+               first_page_number + (last - first) &&
+           pages[last]->page_number() < group_end) {
+      ++last;
+    }
+    assert(last == pages.size() ||
+           pages[last]->page_number() > pages[last - 1]->page_number());
+
+    // Gather the run into one write from the pages themselves.
+    parts.clear();
+    for (std::size_t i = first; i < last; ++i) {
+      if (!isPageUsed(pages[i]->page_number())) {
+        // Page has been deleted since it was read.
+        throw InvalidPageException(pages[i]->page_number(), filename_);
+      }
+      addPageParts(parts, &pages[i]->header_, &pages[i]->data_[0]);
+    }
+    writePartsAt(parts, pagePosition(first_page_number));
+    first = last;
+  }
+}
+
+void File::sync() {
+  if (::fdatasync(descriptor_->fd) != 0) {
+    throw FileIOException(filename_, errno);
+  }
+}
+
+void File::deletePage(const PageId page_number) {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  if (!isPageUsed(page_number)) {
+    throw InvalidPageException(page_number, filename_);
+  }
+  FileHeader header = readHeader();
+  // Clear the page, so that reading it fails, then mark it free.
+  Page existing_page;
+  writePage(page_number, existing_page);
+  setPageUsed(page_number, false);
+  descriptor_->free_hint = std::min(descriptor_->free_hint, page_number);
+  --header.num_used_pages;
+  writeHeader(header);
+}
+
+PageId File::numUsedPages() const {
+  return readHeader().num_used_pages;
+}
+
+void File::setExtentPages(const PageId pages) {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  descriptor_->extent_pages = std::max<PageId>(pages, 1);
+}
+
+PageId File::extentPages() const {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  return descriptor_->extent_pages;
+}
+
+FileIterator File::begin() {
+  return FileIterator(this, nextUsedPage(Page::INVALID_NUMBER));
+}
+
+FileIterator File::end() {
+  return FileIterator(this, Page::INVALID_NUMBER);
+}
+
+File::File(const std::string& name, const bool create_new)
+  : filename_(name),
+    id_(next_id_++) {
+  openIfNeeded(create_new);
+
+  if (create_new) {
+    // File starts with 1 page (the header).
+    FileHeader header = {FORMAT_MAGIC, FORMAT_VERSION, 1 /* num_pages */,
+                         0 /* num_used_pages */};
+    writeHeader(header);
+  }
+}
+
+void File::openIfNeeded(const bool create_new) {
+  std::lock_guard<std::mutex> guard(open_files_latch_);
+  if (open_counts_.find(filename_) != open_counts_.end()) {	//exists an entry already
+    ++open_counts_[filename_];
+    descriptor_ = open_descriptors_[filename_];
+    latch_ = open_latches_[filename_];
+  } else {
+    int flags = O_RDWR;
+    const bool already_exists = exists(filename_);
+    if (create_new) {
+      // Error if we try to overwrite an existing file.
+      if (already_exists) {
+        throw FileExistsException(filename_);
+      }
+      flags |= O_CREAT | O_TRUNC;
+    } else {
+      // Error if we try to open a file that doesn't exist.
+      if (!already_exists) {
+        throw FileNotFoundException(filename_);
+      }
+    }
+    const int fd = ::open(filename_.c_str(), flags, 0666);
+    if (fd < 0) {
+      throw FileIOException(filename_, errno);
+    }
+    descriptor_.reset(new Descriptor(fd));
+    latch_.reset(new std::recursive_mutex());
+    if (!create_new) {
+      readAt(&descriptor_->header, sizeof(FileHeader), 0 /* position */);
+      if (descriptor_->header.magic != FORMAT_MAGIC) {
+        upgradeLegacyFile();
+        readAt(&descriptor_->header, sizeof(FileHeader), 0 /* position */);
+      }
+      if (descriptor_->header.version != FORMAT_VERSION) {
+        throw FileIOException(filename_, EINVAL);
+      }
+      descriptor_->num_pages = descriptor_->header.num_pages;
+      loadPageDirectory();
+    }
+    struct stat status;
+    if (::fstat(descriptor_->fd, &status) != 0) {
+      throw FileIOException(filename_, errno);
+    }
+    descriptor_->reserved_end = status.st_size;
+    open_descriptors_[filename_] = descriptor_;
+    open_latches_[filename_] = latch_;
+    open_counts_[filename_] = 1;
+  }
+}
+
+void File::close() {
+  std::lock_guard<std::mutex> guard(open_files_latch_);
+  --open_counts_[filename_];
+  descriptor_.reset();
+  latch_.reset();
+  if (open_counts_[filename_] == 0) {
+    open_descriptors_.erase(filename_);
+    open_latches_.erase(filename_);
+    open_counts_.erase(filename_);
+  }
+}
+
+void File::writePage(const PageId page_number, const Page& new_page) {
+  writePage(page_number, new_page.header_, new_page);
+}
+
+void File::writePage(const PageId page_number, const PageHeader& header,
+                     const Page& new_page) {
+  std::vector<struct iovec> parts;
+  addPageParts(parts, &header, &new_page.data_[0]);
+  writePartsAt(parts, pagePosition(page_number));
+}
+
+FileHeader File::readHeader() const {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  return descriptor_->header;
+}
+
+void File::writeHeader(const FileHeader& header) {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  if (header == descriptor_->header) {
+    return;
+  }
+  writeAt(&header, sizeof(header), 0 /* position */);
+  descriptor_->header = header;
+  descriptor_->num_pages = header.num_pages;
+}
+
+void File::loadPageDirectory() {
+  std::vector<std::uint64_t>& used_pages = descriptor_->used_pages;
+  const std::size_t bitmaps = bitmapCount(descriptor_->header.num_pages);
+  used_pages.assign(bitmaps * WORDS_PER_BITMAP, 0);
+  for (std::size_t group = 0; group < bitmaps; ++group) {
+    readAt(&used_pages[group * WORDS_PER_BITMAP], Page::SIZE,
+           bitmapPosition(group));
+  }
+  descriptor_->free_hint = nextFreePage(1);
+}
+
+void File::upgradeLegacyFile() {
+  LegacyFileHeader legacy;
+  readAt(&legacy, sizeof(legacy), 0 /* position */);
+
+  const std::string upgraded_name = filename_ + ".upgrade";
+  const int fd = ::open(upgraded_name.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+                        0666);
+  if (fd < 0) {
+    throw FileIOException(upgraded_name, errno);
+  }
+  std::shared_ptr<Descriptor> upgraded(new Descriptor(fd));
+  FileHeader header = {FORMAT_MAGIC, FORMAT_VERSION, legacy.num_pages,
+                       0 /* num_used_pages */};
+  std::vector<std::uint64_t> used_pages(
+      bitmapCount(legacy.num_pages) * WORDS_PER_BITMAP, 0);
+  std::vector<char> buffer(Page::SIZE);
+  for (PageId page_number = 1; page_number < legacy.num_pages;
+       ++page_number) {
+    readAt(&buffer[0], Page::SIZE,
+           sizeof(legacy) + off_t(page_number - 1) * Page::SIZE);
+    PageHeader page_header;
+    std::memcpy(&page_header, &buffer[0], sizeof(page_header));
+    if (page_header.current_page_number == page_number) {
+      used_pages[(page_number - 1) / 64] |=
+          std::uint64_t(1) << ((page_number - 1) % 64);
+      ++header.num_used_pages;
+    }
+    writeFully(fd, &buffer[0], Page::SIZE, pagePosition(page_number),
+               upgraded_name);
+  }
+  for (std::size_t group = 0; group < bitmapCount(legacy.num_pages);
+       ++group) {
+    writeFully(fd, &used_pages[group * WORDS_PER_BITMAP], Page::SIZE,
+               bitmapPosition(group), upgraded_name);
+  }
+  writeFully(fd, &header, sizeof(header), 0 /* position */, upgraded_name);
+
+  // Only replace the old file once the new one is safely on disk, and make
+  // the rename itself durable by syncing the directory that holds the file.
+  if (::fsync(fd) != 0 ||
+      ::rename(upgraded_name.c_str(), filename_.c_str()) != 0) {
+    throw FileIOException(upgraded_name, errno);
+  }
+  const std::string::size_type slash = filename_.rfind('/');
+  const std::string directory =
+      slash == std::string::npos ? "." : filename_.substr(0, slash + 1);
+  const int directory_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (directory_fd < 0) {
+    throw FileIOException(directory, errno);
+  }
+  const int result = ::fsync(directory_fd);
+  const int error_number = errno;
+  ::close(directory_fd);
+  if (result != 0) {
+    throw FileIOException(directory, error_number);
+  }
+  descriptor_ = upgraded;
+}
+
+bool File::reserveExtent(const PageId page_number) {
+  const PageId extent_pages = descriptor_->extent_pages;
+  const off_t page_end = pagePosition(page_number) + off_t(Page::SIZE);
+  if (page_end <= descriptor_->reserved_end) {
+    return true;
+  }
+  if (extent_pages == 1) {
+    return false;
+  }
+  // The extent takes in any bitmap block that falls inside it.
+  const off_t extent_end = pagePosition(page_number + extent_pages);
+  if (!preallocate(descriptor_->fd, descriptor_->reserved_end,
+                   extent_end - descriptor_->reserved_end)) {
+    return false;
+  }
+  descriptor_->reserved_end = extent_end;
+  return true;
+}
+
+bool File::isPageUsed(const PageId page_number) const {
+  if (page_number == Page::INVALID_NUMBER ||
+      page_number >= descriptor_->header.num_pages) {
+    return false;
+  }
+  const PageId index = page_number - 1;
+  return (descriptor_->used_pages[index / 64] >> (index % 64)) & 1;
+}
+
+void File::setPageUsed(const PageId page_number, const bool used) {
+  std::vector<std::uint64_t>& used_pages = descriptor_->used_pages;
+  const PageId index = page_number - 1;
+  const std::size_t word = index / 64;
+  if (word >= used_pages.size()) {
+    // The page starts a new group, and with it a new bitmap.
+    used_pages.resize(used_pages.size() + WORDS_PER_BITMAP, 0);
+  }
+  if (used) {
+    used_pages[word] |= std::uint64_t(1) << (index % 64);
+  } else {
+    used_pages[word] &= ~(std::uint64_t(1) << (index % 64));
+  }
+  const std::size_t group = word / WORDS_PER_BITMAP;
+  writeAt(&used_pages[word], sizeof(std::uint64_t),
+          bitmapPosition(group) +
+              (word - group * WORDS_PER_BITMAP) * sizeof(std::uint64_t));
+}
+
+PageId File::nextUsedPage(const PageId page_number) const {
+  std::lock_guard<std::recursive_mutex> guard(*latch_);
+  const std::vector<std::uint64_t>& used_pages = descriptor_->used_pages;
+  // Bit page_number is the page after the given one.
+  std::size_t word = page_number / 64;
+  if (word >= used_pages.size()) {
+    return Page::INVALID_NUMBER;
+  }
+  std::uint64_t bits =
+      used_pages[word] & (~std::uint64_t(0) << (page_number % 64));
+  while (bits == 0) {
+    if (++word == used_pages.size()) {
+      return Page::INVALID_NUMBER;
+    }
+    bits = used_pages[word];
+  }
+  return word * 64 + __builtin_ctzll(bits) + 1;
+}
+
+PageId File::nextFreePage(const PageId page_number) const {
+  const std::vector<std::uint64_t>& used_pages = descriptor_->used_pages;
+  const PageId num_pages = descriptor_->header.num_pages;
+  const PageId index = page_number - 1;
+  std::size_t word = index / 64;
+  if (word >= used_pages.size()) {
+    return num_pages;
+  }
+  std::uint64_t bits =
+      ~used_pages[word] & (~std::uint64_t(0) << (index % 64));
+  while (bits == 0) {
+    if (++word == used_pages.size()) {
+      return num_pages;
+    }
+    bits = ~used_pages[word];
+  }
+  // Bits past the last page of the file are clear, but not free pages.
+  return std::min<PageId>(word * 64 + __builtin_ctzll(bits) + 1, num_pages);
+}
+
+void File::readAt(void* buffer, const std::size_t size,
+                  const off_t position) const {
+  readFully(descriptor_->fd, buffer, size, position, filename_);
+}
+
+void File::writeAt(const void* buffer, const std::size_t size,
+                   const off_t position) {
+  writeFully(descriptor_->fd, buffer, size, position, filename_);
+}
+
+void File::readPartsAt(std::vector<struct iovec>& parts,
+                       off_t position) const {
+  std::size_t next = 0;
+  while (next < parts.size()) {
+    const int count = std::min<std::size_t>(parts.size() - next, IOV_MAX);
+    const ssize_t result = ::preadv(descriptor_->fd, &parts[next], count,
+                                    position);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      throw FileIOException(filename_, result < 0 ? errno : 0);
+    }
+    position += result;
+    skipParts(parts, next, result);
+  }
+}
+
+void File::writePartsAt(std::vector<struct iovec>& parts, off_t position) {
+  std::size_t next = 0;
+  while (next < parts.size()) {
+    const int count = std::min<std::size_t>(parts.size() - next, IOV_MAX);
+    const ssize_t result = ::pwritev(descriptor_->fd, &parts[next], count,
+                                     position);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result < 0) {
+      throw FileIOException(filename_, errno);
+    }
+    position += result;
+    skipParts(parts, next, result);
+  }
+}
+
+File::Descriptor::~Descriptor() {
+  ::close(fd);
+}
+
+}
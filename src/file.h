@@ -1,332 +1,675 @@
-/**
- * @author See Contributors.txt for code contributors and overview of BadgerDB.
- *
- * @section LICENSE
- * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
- */
-
-#pragma once
-
-#include <fstream>
-#include <string>
-#include <map>
-#include <memory>
-
-#include "page.h"
-
-namespace badgerdb {
-
-class FileIterator;
-
-/**
- * @brief Header metadata for files on disk which contain pages.
- */
-struct FileHeader {
-  /**
-   * Number of pages allocated in the file.
-   */
-  PageId num_pages;
-
-  /**
-   * Page number of the first used page in the file.
-   */
-  PageId first_used_page;
-
-  /**
-   * Number of free pages (allocated but unused) in the file.
-   */
-  PageId num_free_pages;
-
-  /**
-   * Page number of the first free (allocated but unused) page in the file.
-   */
-  PageId first_free_page;
-
-  /**
-   * Returns true if this file header is equal to the other.
-   *
-   * @param rhs   Other file header to compare against.
-   * @return  True if the other header is equal to this one.
-   */
-  bool operator==(const FileHeader& rhs) const {
-    return num_pages == rhs.num_pages &&
-        num_free_pages == rhs.num_free_pages &&
-        first_used_page == rhs.first_used_page &&
-        first_free_page == rhs.first_free_page;
-  }
-};
-
-/**
- * @brief Class which represents a file in the filesystem containing database
- *        pages.
- *
- * The File class wraps a stream to an underlying file on disk.  Files contain
- * fixed-sized pages, and they never deallocate space (though they do reuse
- * deleted pages if possible).  If multiple File objects refer to the same
- * underlying file, they will share the stream in memory.
- * If a file that has already been opened (possibly by another query), then the File class
- * detects this (by looking in the open_streams_ map) and just returns a file object with
- * the already created stream for the file without actually opening the UNIX file again. 
- *
- * @warning This class is not threadsafe.
- */
-class File {
- public:
-  /**
-   * Creates a new file.
-   *
-   * @param filename  Name of the file.
-   * @throws  FileExistsException     If the requested file already exists.
-   */
-  static File create(const std::string& filename);
-
-  /**
-   * Opens the file named fileName and returns the corresponding File object.
-	 * It first checks if the file is already open. If so, then the new File object created uses the same input-output stream to read to or write fom
-	 * that already open file. Reference count (open_counts_ static variable inside the File object) is incremented whenever an already open file is
-	 * opened again. Otherwise the UNIX file is actually opened. The fileName and the stream associated with this File object are inserted into the
-	 * open_streams_ map.
-   *
-   * @param filename  Name of the file.
-   * @throws  FileNotFoundException   If the requested file doesn't exist.
-   */
-  static File open(const std::string& filename);
-
-  /**
-   * Deletes an existing file.
-   *
-   * @param filename  Name of the file.
-   * @throws  FileNotFoundException   If the file doesn't exist.
-   * @throws  FileOpenException       If the file is currently open.
-   */
-  static void remove(const std::string& filename);
-
-  /**
-   * Returns true if the file exists and is open.
-   *
-   * @param filename  Name of the file.
-   */
-  static bool isOpen(const std::string& filename);
-
-
-  /**
-   * Returns true if the file exists and is open.
-   *
-   * @param filename  Name of the file.
-   */
-  static bool exists(const std::string& filename);
-
-  /**
-   * Copy constructor.
-   * 
-   * @param other File object to copy.
-   * @return      A copy of the File object.
-   */
-  File(const File& other);
-
-  /**
-   * Assignment operator.
-   *
-   * @param rhs File object to assign.
-   * @return    Newly assigned file object.
-   */
-  File& operator=(const File& rhs);
-
-  /**
-   * Destructor that automatically closes the underlying file if no other
-   * File objects are using it.
-   */
-  ~File();
-
-  /**
-   * Allocates a new page in the file.
-   *
-   * @return The new page.
-   */
-  Page allocatePage();
-
-  /**
-   * Reads an existing page from the file.
-   *
-   * @param page_number   Number of page to read.
-   * @return  The page.
-   * @throws  InvalidPageException  If the page doesn't exist in the file or is
-   *                                not currently used.
-   */
-  Page readPage(const PageId page_number) const;
-
-  /**
-   * Writes a page into the file, replacing any existing contents.  The page
-   * must have been already allocated in this file by a call to allocatePage().
-   *
-   * @see allocatePage()
-   * @param new_page  Page to write.
-   */
-  void writePage(const Page& new_page);
-
-  /**
-   * Deletes a page from the file.
-   *
-   * @param page_number   Number of page to delete.
-   */
-  void deletePage(const PageId page_number);
-
-  /**
-   * Returns the name of the file this object represents.
-   *
-   * @return Name of file.
-   */
-  const std::string& filename() const { return filename_; }
-
-  /**
-   * Returns an iterator at the first page in the file.
-   *
-   * @return  Iterator at first page of file.
-   */
-  FileIterator begin();
-
-  /**
-   * Returns an iterator representing the page after the last page in the file.
-   * This iterator should not be dereferenced.
-   *
-   * @return  Iterator representing page after the last page in the file.
-   */
-  FileIterator end();
-
- private:
-  /**
-   * Returns the position of the page with the given number in the file (as an
-   * offset from the beginning of the file).
-   *
-   * @param page_number   Number of page.
-   * @return  Position of page in file.
-   */
-  static std::streampos pagePosition(const PageId page_number) {
-    return sizeof(FileHeader) + ((page_number - 1) * Page::SIZE);
-  }
-
-  /**
-   * Constructs a file object representing a file on the filesystem.
-   * This method should not be called directly; instead use the static methods
-   * on this class.
-   *
-   * @see File::create()
-   * @see File::open()
-   * @param name        Name of file.
-   * @param create_new  Whether to create a new file.
-   * @throws  FileExistsException     If the underlying file exists and
-   *                                  create_new is true.
-   * @throws  FileNotFoundException   If the underlying file doesn't exist and
-   *                                  create_new is false.
-   */
-  File(const std::string& name, const bool create_new);
-
-  /**
-   * Opens the underlying file named in filename_.
-   * This method only opens the file if no other File objects exist that access
-   * the same filesystem file; otherwise, it reuses the existing stream.
-   *
-   * @param create_new  Whether to create a new file.
-   * @throws  FileExistsException     If the underlying file exists and
-   *                                  create_new is true.
-   * @throws  FileNotFoundException   If the underlying file doesn't exist and
-   *                                  create_new is false.
-   */
-  void openIfNeeded(const bool create_new);
-
-  /**
-   * Closes the underlying file stream in <stream_>.
-   * This method only closes the file if no other File objects exist that access
-   * the same file.
-   */
-  void close();
-
-  /**
-   * Reads a page from the file.  If <allow_free> is not set, an exception
-   * will be thrown if the page read from disk is not currently in use.
-   *
-   * No bounds checking is performed; the underlying file stream will throw
-   * an exception if the page is past the end of the file.
-   *
-   * @param page_number   Number of page to read.
-   * @param allow_free    Whether to allow reading a free (unused) page.
-   * @return  The page.
-   * @throws  InvalidPageException  If the page is free (unused) and
-   *                                allow_free is false.
-   */
-  Page readPage(const PageId page_number, const bool allow_free) const;
-
-  /**
-   * Writes a page into the file at the given page number.  This does not
-   * update ensure that the number in the header equals the position on disk.
-   * No bounds checking is performed.
-   *
-   * @param page_number Number of page whose contents to replace.
-   * @param new_page    Page to write.
-   */
-  void writePage(const PageId page_number, const Page& new_page);
-
-  /**
-   * Writes a page into the file at the given page number with the given header.
-   * This does not ensure that the number in the header equals the position on
-   * disk.  No bounds checking is performed.
-   *
-   * @param page_number Number of page whose contents to replace.
-   * @param header      Header of page to write.
-   * @param new_page    Page to write.
-   */
-  void writePage(const PageId page_number, const PageHeader& header,
-                 const Page& new_page);
-
-  /**
-   * Reads the header for this file from disk.
-   *
-   * @return  The file header.
-   */
-  FileHeader readHeader() const;
-
-  /**
-   * Writes the given header to the disk as the header for this file.
-   *
-   * @param header  File header to write.
-   */
-  void writeHeader(const FileHeader& header);
-
-  /**
-   * Reads only the header of the given page from disk (not the record data
-   * or slot table).  No bounds checking is performed.
-   *
-   * @param page_number   Number of page whose header is to be read.
-   * @return  Header of page.
-   */
-  PageHeader readPageHeader(const PageId page_number) const;
-
-  typedef std::map<std::string,
-                   std::shared_ptr<std::fstream> > StreamMap;
-  typedef std::map<std::string, int> CountMap;
-
-  /**
-   * Streams for opened files.
-   */
-  static StreamMap open_streams_;
-
-  /**
-   * Counts for opened files.
-   */
-  static CountMap open_counts_;
-
-  /**
-   * Name of the file this object represents.
-   */
-  std::string filename_;
-
-  /**
-   * Stream for underlying filesystem object.
-   */
-  std::shared_ptr<std::fstream> stream_;
-
-  friend class FileIterator;
-  friend class FileTest;
-};
-
-}
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "page.h"
+
+namespace badgerdb {
+
+class FileIterator;
+
+/**
+ * @brief Header metadata for files on disk which contain pages.
+ */
+struct FileHeader {
+  /**
+   * Marks the file as being in the page directory format; File::FORMAT_MAGIC.
+   */
+  std::uint32_t magic;
+
+  /**
+   * Version of the file format; File::FORMAT_VERSION.
+   */
+  std::uint32_t version;
+
+  /**
+   * Number of pages allocated in the file.
+   */
+  PageId num_pages;
+
+  /**
+   * Number of used pages in the file.
+   */
+  PageId num_used_pages;
+
+  /**
+   * Returns true if this file header is equal to the other.
+   *
+   * @param rhs   Other file header to compare against.
+   * @return  True if the other header is equal to this one.
+   */
+  bool operator==(const FileHeader& rhs) const {
+    return magic == rhs.magic &&
+        version == rhs.version &&
+        num_pages == rhs.num_pages &&
+        num_used_pages == rhs.num_used_pages;
+  }
+};
+
+/**
+ * @brief Class which represents a file in the filesystem containing database
+ *        pages.
+ *
+ * The File class wraps a descriptor of an underlying file on disk.  Files
+ * contain fixed-sized pages, and they never deallocate space (though they do
+ * reuse deleted pages if possible).  If multiple File objects refer to the
+ * same underlying file, they will share the descriptor.
+ * If a file that has already been opened (possibly by another query), then the File class
+ * detects this (by looking in the open_descriptors_ map) and just returns a file object with
+ * the already opened descriptor for the file without actually opening the UNIX file again. 
+ *
+ * On disk, the file header is followed by groups of pages, each made of a
+ * bitmap block with one bit per page telling whether it is used, and the
+ * PAGES_PER_BITMAP pages it covers.  The bitmaps are read when the file is
+ * opened and kept in memory, so finding a free page, counting used pages and
+ * walking the used pages in page number order take no I/O.  Files in the
+ * earlier format, which linked used and free pages through their headers,
+ * are rewritten in this format when they are opened.
+ *
+ * Pages are read and written with positional I/O at their offset in the file,
+ * so there is no shared file position and page reads need no latch.  File
+ * objects that share a descriptor also share a latch, which the methods that
+ * write pages or change the page directory and file header hold for their
+ * duration.  Page reads, writes, allocations and deletions can therefore be
+ * issued from several threads, as a concurrent buffer manager does, as long as
+ * each thread uses a File object that outlives the calls.  FileIterator holds
+ * the latch only while it looks up the next used page.
+ */
+class File {
+ public:
+  /**
+   * Creates a new file.
+   *
+   * @param filename  Name of the file.
+   * @throws  FileExistsException     If the requested file already exists.
+   */
+  static File create(const std::string& filename);
+
+  /**
+   * Opens the file named fileName and returns the corresponding File object.
+	 * It first checks if the file is already open. If so, then the new File object created uses the same file descriptor to read to or write fom
+	 * that already open file. Reference count (open_counts_ static variable inside the File object) is incremented whenever an already open file is
+	 * opened again. Otherwise the UNIX file is actually opened. The fileName and the descriptor associated with this File object are inserted into the
+	 * open_descriptors_ map.
+   *
+   * @param filename  Name of the file.
+   * @throws  FileNotFoundException   If the requested file doesn't exist.
+   */
+  static File open(const std::string& filename);
+
+  /**
+   * Deletes an existing file.
+   *
+   * @param filename  Name of the file.
+   * @throws  FileNotFoundException   If the file doesn't exist.
+   * @throws  FileOpenException       If the file is currently open.
+   */
+  static void remove(const std::string& filename);
+
+  /**
+   * Returns true if the file exists and is open.
+   *
+   * @param filename  Name of the file.
+   */
+  static bool isOpen(const std::string& filename);
+
+
+  /**
+   * Returns true if the file exists and is open.
+   *
+   * @param filename  Name of the file.
+   */
+  static bool exists(const std::string& filename);
+
+  /**
+   * Copy constructor.
+   * 
+   * @param other File object to copy.
+   * @return      A copy of the File object.
+   */
+  File(const File& other);
+
+  /**
+   * Assignment operator.
+   *
+   * @param rhs File object to assign.
+   * @return    Newly assigned file object.
+   */
+  File& operator=(const File& rhs);
+
+  /**
+   * Destructor that automatically closes the underlying file if no other
+   * File objects are using it.
+   */
+  ~File();
+
+  /**
+   * Allocates a new page in the file.  When the file has to grow, it is
+   * extended by a whole extent (see setExtentPages()) at once, and the pages
+   * after the new one are handed out by later allocations without growing
+   * the file again.
+   *
+   * @return The new page.
+   */
+  Page allocatePage();
+
+  /**
+   * Reads an existing page from the file.
+   *
+   * @param page_number   Number of page to read.
+   * @return  The page.
+   * @throws  InvalidPageException  If the page doesn't exist in the file or is
+   *                                not currently used.
+   */
+  Page readPage(const PageId page_number) const;
+
+  /**
+   * Reads a run of consecutive pages from the file, with a single read for
+   * each part of the run that lies within one bitmap group (see groupEnd()).
+   * The run is cut short at the end of the file, and pages in it that are not
+   * currently used are left out.
+   *
+   * @param first_page_number   Number of the first page to read.
+   * @param count               Number of pages in the run.
+   * @return  The used pages of the run in page number order, starting with
+   *          the first page.
+   * @throws  InvalidPageException  If the first page doesn't exist in the
+   *                                file or is not currently used.
+   */
+  std::vector<Page> readPages(const PageId first_page_number,
+                              const PageId count) const;
+
+  /**
+   * Writes a page into the file, replacing any existing contents.  The page
+   * must have been already allocated in this file by a call to allocatePage().
+   *
+   * @see allocatePage()
+   * @param new_page  Page to write.
+   */
+  void writePage(const Page& new_page);
+
+  /**
+   * Writes several pages into the file, replacing any existing contents as
+   * writePage() does.  Pages with consecutive numbers in the same bitmap
+   * group are written together with a single vectored write straight from
+   * the pages.
+   *
+   * @see writePage()
+   * @param pages   Pages to write, in increasing page number order.
+   * @throws  InvalidPageException  If a page has been deleted from the file.
+   *                                The runs before the one holding it have
+   *                                been written.
+   */
+  void writePages(const std::vector<const Page*>& pages);
+
+  /**
+   * Waits until the pages written to the file are on disk.  Writes only hand
+   * pages to the operating system; call this when they have to survive a
+   * crash.
+   *
+   * @throws  FileIOException  If the pages could not be written to disk.
+   */
+  void sync();
+
+  /**
+   * Deletes a page from the file.
+   *
+   * @param page_number   Number of page to delete.
+   * @throws  InvalidPageException  If the page is not currently used.
+   */
+  void deletePage(const PageId page_number);
+
+  /**
+   * Returns the number of pages currently used in the file.
+   *
+   * @return  Number of used pages.
+   */
+  PageId numUsedPages() const;
+
+  /**
+   * Sets the number of pages the file is extended by when it has to grow.
+   * The space is preallocated on disk with fallocate() where the file system
+   * supports it, so appending pages does not update file system metadata for
+   * every page.  A size of 1 grows the file one page at a time without
+   * preallocating.  The setting is shared by all File objects of the file
+   * and lasts while it is open.
+   *
+   * @param pages   Number of pages per extent.
+   */
+  void setExtentPages(const PageId pages);
+
+  /**
+   * Returns the number of pages the file is extended by when it has to grow.
+   *
+   * @return  Number of pages per extent.
+   */
+  PageId extentPages() const;
+
+  /**
+   * Returns the name of the file this object represents.
+   *
+   * @return Name of file.
+   */
+  const std::string& filename() const { return filename_; }
+
+  /**
+   * Returns the identifier of this File object.  Identifiers are unique among
+   * the File objects created by this process and, unlike the object's
+   * address, do not depend on where the object was allocated.
+   *
+   * @return Identifier of this File object.
+   */
+  std::uint32_t id() const { return id_; }
+
+  /**
+   * Returns an iterator at the first page in the file.
+   *
+   * @return  Iterator at first page of file.
+   */
+  FileIterator begin();
+
+  /**
+   * Returns an iterator representing the page after the last page in the file.
+   * This iterator should not be dereferenced.
+   *
+   * @return  Iterator representing page after the last page in the file.
+   */
+  FileIterator end();
+
+  /**
+   * Returns the first page of the bitmap group after the one holding the
+   * given page.  Pages from page_number up to it are stored one after another
+   * on disk, while the next group's bitmap separates them from the pages that
+   * follow, so a single read or write of consecutive pages stops there.
+   *
+   * @param page_number   Number of page.
+   * @return  Number of the first page of the next group.
+   */
+  static PageId groupEnd(const PageId page_number) {
+    return ((page_number - 1) / PAGES_PER_BITMAP + 1) * PAGES_PER_BITMAP + 1;
+  }
+
+  /**
+   * Value of FileHeader::magic in files in the page directory format.
+   */
+  static const std::uint32_t FORMAT_MAGIC = 0x44504442;
+
+  /**
+   * Version of the file format written by this class.
+   */
+  static const std::uint32_t FORMAT_VERSION = 2;
+
+  /**
+   * Number of pages covered by one bitmap block.
+   */
+  static const PageId PAGES_PER_BITMAP = Page::SIZE * 8;
+
+  /**
+   * Number of pages per extent of a file that has just been opened.
+   */
+  static const PageId DEFAULT_EXTENT_PAGES = 64;
+
+ private:
+  /**
+   * Returns the position of the page with the given number in the file (as an
+   * offset from the beginning of the file).  There is no page 0; its number
+   * marks an invalid page.
+   *
+   * @param page_number   Number of page.
+   * @return  Position of page in file.
+   */
+  static off_t pagePosition(const PageId page_number) {
+    assert(page_number != Page::INVALID_NUMBER);
+    const off_t index = page_number - 1;
+    return sizeof(FileHeader) +
+        (index + index / PAGES_PER_BITMAP + 1) * off_t(Page::SIZE);
+  }
+
+  /**
+   * Returns the position of a bitmap block in the file.
+   *
+   * @param group   Number of the bitmap, counting from 0.
+   * @return  Position of the bitmap in file.
+   */
+  static off_t bitmapPosition(const std::size_t group) {
+    return sizeof(FileHeader) +
+        off_t(group) * (PAGES_PER_BITMAP + 1) * off_t(Page::SIZE);
+  }
+
+  /**
+   * Constructs a file object representing a file on the filesystem.
+   * This method should not be called directly; instead use the static methods
+   * on this class.
+   *
+   * @see File::create()
+   * @see File::open()
+   * @param name        Name of file.
+   * @param create_new  Whether to create a new file.
+   * @throws  FileExistsException     If the underlying file exists and
+   *                                  create_new is true.
+   * @throws  FileNotFoundException   If the underlying file doesn't exist and
+   *                                  create_new is false.
+   */
+  File(const std::string& name, const bool create_new);
+
+  /**
+   * Opens the underlying file named in filename_.
+   * This method only opens the file if no other File objects exist that access
+   * the same filesystem file; otherwise, it reuses the existing descriptor.
+   *
+   * @param create_new  Whether to create a new file.
+   * @throws  FileExistsException     If the underlying file exists and
+   *                                  create_new is true.
+   * @throws  FileNotFoundException   If the underlying file doesn't exist and
+   *                                  create_new is false.
+   * @throws  FileIOException         If the file cannot be opened.
+   */
+  void openIfNeeded(const bool create_new);
+
+  /**
+   * Releases the underlying file descriptor in <descriptor_>.
+   * This method only closes the file if no other File objects exist that access
+   * the same file.
+   */
+  void close();
+
+  /**
+   * Reads a page from the file.  If <allow_free> is not set, an exception
+   * will be thrown if the page read from disk is not currently in use.
+   *
+   * No bounds checking is performed; a FileIOException is thrown if the page
+   * is past the end of the file.
+   *
+   * @param page_number   Number of page to read.
+   * @param allow_free    Whether to allow reading a free (unused) page.
+   * @return  The page.
+   * @throws  InvalidPageException  If the page is free (unused) and
+   *                                allow_free is false.
+   */
+  Page readPage(const PageId page_number, const bool allow_free) const;
+
+  /**
+   * Writes a page into the file at the given page number.  This does not
+   * update ensure that the number in the header equals the position on disk.
+   * No bounds checking is performed.
+   *
+   * @param page_number Number of page whose contents to replace.
+   * @param new_page    Page to write.
+   */
+  void writePage(const PageId page_number, const Page& new_page);
+
+  /**
+   * Writes a page into the file at the given page number with the given header.
+   * This does not ensure that the number in the header equals the position on
+   * disk.  No bounds checking is performed.
+   *
+   * @param page_number Number of page whose contents to replace.
+   * @param header      Header of page to write.
+   * @param new_page    Page to write.
+   */
+  void writePage(const PageId page_number, const PageHeader& header,
+                 const Page& new_page);
+
+  /**
+   * Returns the header for this file, which is kept in memory while the file
+   * is open.
+   *
+   * @return  The file header.
+   */
+  FileHeader readHeader() const;
+
+  /**
+   * Writes the given header to the disk as the header for this file, and
+   * keeps it as the header in memory.
+   *
+   * @param header  File header to write.
+   */
+  void writeHeader(const FileHeader& header);
+
+  /**
+   * Reads size bytes at the given position in the file into buffer.
+   *
+   * @param buffer    Where to put the bytes.
+   * @param size      Number of bytes to read.
+   * @param position  Offset in the file of the first byte.
+   * @throws  FileIOException  If the read fails or the file ends first.
+   */
+  void readAt(void* buffer, const std::size_t size,
+              const off_t position) const;
+
+  /**
+   * Writes size bytes from buffer at the given position in the file.
+   *
+   * @param buffer    Bytes to write.
+   * @param size      Number of bytes to write.
+   * @param position  Offset in the file of the first byte.
+   * @throws  FileIOException  If the write fails.
+   */
+  void writeAt(const void* buffer, const std::size_t size,
+               const off_t position);
+
+  /**
+   * Reads consecutive bytes at the given position in the file into the
+   * buffers described by parts, in as few calls as it takes.
+   *
+   * @param parts     Buffers to fill, in order.  They are used up as the read
+   *                  goes on.
+   * @param position  Offset in the file of the first byte.
+   * @throws  FileIOException  If the read fails or the file ends first.
+   */
+  void readPartsAt(std::vector<struct iovec>& parts, off_t position) const;
+
+  /**
+   * Writes the buffers described by parts one after another at the given
+   * position in the file, in as few calls as it takes.
+   *
+   * @param parts     Buffers to write, in order.  They are used up as the
+   *                  write goes on.
+   * @param position  Offset in the file of the first byte.
+   * @throws  FileIOException  If the write fails.
+   */
+  void writePartsAt(std::vector<struct iovec>& parts, off_t position);
+
+  /**
+   * Reads the bitmaps of the file into the page directory.
+   */
+  void loadPageDirectory();
+
+  /**
+   * Rewrites a file in the earlier format, whose header has just been read,
+   * in the current one: pages whose header holds their own number are used,
+   * the others free.  The new file replaces the old one under its name, with
+   * the directory synced so the rename survives a crash, and the descriptor
+   * is switched to it.
+   *
+   * @throws  FileIOException  If the old file cannot be read or the new one
+   *                           written.
+   */
+  void upgradeLegacyFile();
+
+  /**
+   * Returns true if the page is used, according to the page directory.
+   * Caller holds the file latch.
+   *
+   * @param page_number   Number of page.
+   */
+  bool isPageUsed(const PageId page_number) const;
+
+  /**
+   * Marks a page used or free, in the page directory and in its bitmap on
+   * disk.  Caller holds the file latch.
+   *
+   * @param page_number   Number of page.
+   * @param used          True if the page is now used.
+   */
+  void setPageUsed(const PageId page_number, const bool used);
+
+  /**
+   * Returns the first used page after the given one.
+   *
+   * @param page_number   Number of page to start after, or
+   *                      Page::INVALID_NUMBER to start at the beginning.
+   * @return  Number of the next used page, or Page::INVALID_NUMBER if there
+   *          is none.
+   */
+  PageId nextUsedPage(const PageId page_number) const;
+
+  /**
+   * Returns the lowest free page at or after the given one.  Caller holds the
+   * file latch.
+   *
+   * @param page_number   Number of page to start at.
+   * @return  Number of the free page, or the number of pages in the file if
+   *          the file has to grow.
+   */
+  PageId nextFreePage(const PageId page_number) const;
+
+  /**
+   * Makes sure the file has space on disk for a page past its last one,
+   * preallocating an extent from the page on if it does not.  Failing to
+   * preallocate is not an error, as the page write that follows extends the
+   * file anyway.  Caller holds the file latch.
+   *
+   * @param page_number   Number of page about to be written.
+   * @return  True if the page lies in preallocated space, which reads as
+   *          zeros.
+   */
+  bool reserveExtent(const PageId page_number);
+
+  /**
+   * @brief Owner of the descriptor of an open file, which it closes when the
+   *        last File object using it lets go, and of the file's header and
+   *        page directory.
+   */
+  struct Descriptor {
+    /**
+     * Takes ownership of the given descriptor.
+     *
+     * @param fd  Open file descriptor.
+     */
+    explicit Descriptor(const int fd)
+        : fd(fd), header(), num_pages(0), free_hint(1), reserved_end(0),
+          extent_pages(DEFAULT_EXTENT_PAGES) {}
+
+    /**
+     * Closes the descriptor.
+     */
+    ~Descriptor();
+
+    /**
+     * The file descriptor.
+     */
+    const int fd;
+
+    /**
+     * The file header as last read or written, so it is read from disk only
+     * when the file is opened.  Guarded by the file latch.
+     */
+    FileHeader header;
+
+    /**
+     * Copy of header.num_pages for page reads, which take no latch.  Pages
+     * are never given back, so it only grows.
+     */
+    std::atomic<PageId> num_pages;
+
+    /**
+     * Page directory: the bitmaps of the file, one after another, with page
+     * p at bit (p - 1) % 64 of word (p - 1) / 64.  Guarded by the file latch.
+     */
+    std::vector<std::uint64_t> used_pages;
+
+    /**
+     * No page below this one is free.  Guarded by the file latch.
+     */
+    PageId free_hint;
+
+    /**
+     * Size of the file on disk, including space preallocated past its last
+     * page.  Guarded by the file latch.
+     */
+    off_t reserved_end;
+
+    /**
+     * Number of pages the file grows by.  Guarded by the file latch.
+     */
+    PageId extent_pages;
+
+   private:
+    Descriptor(const Descriptor&);
+    Descriptor& operator=(const Descriptor&);
+  };
+
+  typedef std::map<std::string,
+                   std::shared_ptr<Descriptor> > DescriptorMap;
+  typedef std::map<std::string,
+                   std::shared_ptr<std::recursive_mutex> > LatchMap;
+  typedef std::map<std::string, int> CountMap;
+
+  /**
+   * Descriptors for opened files.
+   */
+  static DescriptorMap open_descriptors_;
+
+  /**
+   * Latches for opened files.
+   */
+  static LatchMap open_latches_;
+
+  /**
+   * Counts for opened files.
+   */
+  static CountMap open_counts_;
+
+  /**
+   * Protects open_descriptors_, open_latches_ and open_counts_.
+   */
+  static std::mutex open_files_latch_;
+
+  /**
+   * Identifier to hand out to the next File object constructed.
+   */
+  static std::atomic<std::uint32_t> next_id_;
+
+  /**
+   * Name of the file this object represents.
+   */
+  std::string filename_;
+
+  /**
+   * Identifier of this File object.
+   */
+  std::uint32_t id_;
+
+  /**
+   * Descriptor for underlying filesystem object.
+   */
+  std::shared_ptr<Descriptor> descriptor_;
+
+  /**
+   * Latch serializing page writes and changes to the page directory and file
+   * header among all File objects sharing descriptor_.  It is recursive
+   * because allocatePage() and deletePage() call other public methods.
+   */
+  std::shared_ptr<std::recursive_mutex> latch_;
+
+  friend class FileIterator;
+  friend class FileTest;
+};
+
+}
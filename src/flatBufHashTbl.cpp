@@ -0,0 +1,137 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "flatBufHashTbl.h"
+#include "exceptions/hash_already_present_exception.h"
+#include "exceptions/hash_not_found_exception.h"
+
+namespace badgerdb {
+
+std::uint32_t FlatBufHashTbl::hash(const File* file, const PageId pageNo) const
+{
+  return (std::uint32_t)(hashKey(file, pageNo) & mask);
+}
+
+FlatBufHashTbl::FlatBufHashTbl(const std::uint32_t htSize)
+	: capacity(roundUpToPowerOfTwo(htSize)), mask(capacity - 1), count(0)
+{
+  slots = new flatBucket[capacity];
+  for (std::uint32_t i = 0; i < capacity; i++)
+    slots[i].file = NULL;
+}
+
+FlatBufHashTbl::~FlatBufHashTbl()
+{
+  delete [] slots;
+}
+
+void FlatBufHashTbl::grow()
+{
+  flatBucket* oldSlots = slots;
+  std::uint32_t oldCapacity = capacity;
+
+  // allocate before touching the table, so it is left intact if new throws
+  slots = new flatBucket[oldCapacity * 2];
+  capacity = oldCapacity * 2;
+  mask = capacity - 1;
+  for (std::uint32_t i = 0; i < capacity; i++)
+    slots[i].file = NULL;
+
+  // reinsert every entry at its position in the larger table
+  for (std::uint32_t i = 0; i < oldCapacity; i++) {
+    if (oldSlots[i].file == NULL)
+      continue;
+    std::uint32_t index = hash(oldSlots[i].file, oldSlots[i].pageNo);
+    while (slots[index].file != NULL)
+      index = (index + 1) & mask;
+    slots[index] = oldSlots[i];
+  }
+  delete [] oldSlots;
+}
+
+std::uint32_t FlatBufHashTbl::findSlot(const File* file, const PageId pageNo)
+{
+  std::uint32_t index = hash(file, pageNo);
+  // the table is never full, so the probe terminates
+  while (slots[index].file != NULL) {
+    if (slots[index].file == file && slots[index].pageNo == pageNo)
+      return index;
+    index = (index + 1) & mask;
+  }
+  return capacity;
+}
+
+void FlatBufHashTbl::insert(const File* file, const PageId pageNo, const FrameId frameNo)
+{
+  std::uint32_t index = hash(file, pageNo);
+  while (slots[index].file != NULL) {
+    if (slots[index].file == file && slots[index].pageNo == pageNo)
+      throw HashAlreadyPresentException(file->filename(), pageNo, slots[index].frameNo);
+    index = (index + 1) & mask;
+  }
+
+  // keep the table at most three quarters full so probe runs stay short
+  if ((count + 1) * 4 > capacity * 3) {
+    grow();
+    index = hash(file, pageNo);
+    while (slots[index].file != NULL)
+      index = (index + 1) & mask;
+  }
+
+  slots[index].file = file;
+  slots[index].pageNo = pageNo;
+  slots[index].frameNo = frameNo;
+  count++;
+}
+
+bool FlatBufHashTbl::find(const File* file, const PageId pageNo, FrameId &frameNo)
+{
+  std::uint32_t index = findSlot(file, pageNo);
+  if (index == capacity)
+    return false;
+
+  frameNo = slots[index].frameNo; // return frameNo by reference
+  return true;
+}
+
+void FlatBufHashTbl::remove(const File* file, const PageId pageNo)
+{
+  std::uint32_t hole = findSlot(file, pageNo);
+  if (hole == capacity)
+    throw HashNotFoundException(file->filename(), pageNo);
+
+  // Backward shift deletion: pull later entries of the probe run into the
+  // hole whenever the hole lies between their home slot and their current
+  // slot, so that lookups never need tombstones to keep probing.
+  std::uint32_t next = (hole + 1) & mask;
+  while (slots[next].file != NULL) {
+    std::uint32_t home = hash(slots[next].file, slots[next].pageNo);
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      slots[hole] = slots[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  slots[hole].file = NULL;
+  count--;
+}
+
+void FlatBufHashTbl::probeHistogram(std::vector<std::uint32_t> &histogram) const
+{
+  histogram.clear();
+  for (std::uint32_t i = 0; i < capacity; i++) {
+    if (slots[i].file == NULL)
+      continue;
+    // an entry displaced d slots from home takes d+1 comparisons to reach
+    std::uint32_t depth = (i - hash(slots[i].file, slots[i].pageNo)) & mask;
+    if (histogram.size() <= depth)
+      histogram.resize(depth + 1, 0);
+    histogram[depth]++;
+  }
+}
+
+}
@@ -0,0 +1,147 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include "bufHashIndex.h"
+
+namespace badgerdb {
+
+/**
+* @brief Entry of the open addressing buffer pool hash table, stored inline in the table
+*/
+struct flatBucket {
+	/**
+	 * pointer a file object, NULL if the slot is empty
+	 */
+	const File *file;
+
+	/**
+	 * page number within a file
+	 */
+	PageId pageNo;
+
+	/**
+	 * frame number of page in the buffer pool
+	 */
+	FrameId frameNo;
+};
+
+
+/**
+* @brief Open addressing hash table class to keep track of pages in the buffer pool
+*
+* Entries live directly in one flat array and collisions are resolved by
+* linear probing, so a lookup usually touches a single cache line and inserts
+* and removes never allocate.  Removal shifts the following entries of the
+* probe sequence back instead of leaving tombstones behind.  The table
+* doubles in size if it gets more than three quarters full, which a table
+* sized for the whole buffer pool never does.
+*
+* @warning This class is not threadsafe.
+*/
+class FlatBufHashTbl : public BufHashIndex
+{
+ private:
+	/**
+	 * Number of slots in the table, always a power of two
+	 */
+  std::uint32_t capacity;
+
+	/**
+	 * capacity - 1, used to wrap slot indices
+	 */
+  std::uint32_t mask;
+
+	/**
+	 * Number of entries currently stored
+	 */
+  std::uint32_t count;
+
+	/**
+	 * Actual Hash table object
+	 */
+  flatBucket* slots;
+
+	/**
+	 * returns the home slot between 0 and capacity-1 computed using file and pageNo
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 * @return  			Hash value.
+	 */
+  std::uint32_t hash(const File* file, const PageId pageNo) const;
+
+	/**
+	 * doubles the number of slots and reinserts all entries
+	 *
+   * @throws  std::bad_alloc if the larger table could not be allocated, leaving the table as it was
+	 */
+  void grow();
+
+	/**
+	 * returns the slot holding (file, pageNo) or capacity if there is none
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+	 * @return  			Slot index.
+	 */
+  std::uint32_t findSlot(const File* file, const PageId pageNo);
+
+ public:
+	/**
+   * Constructor of FlatBufHashTbl class
+	 *
+	 * @param htSize  Minimum number of slots; rounded up to a power of two
+	 */
+	FlatBufHashTbl(const std::uint32_t htSize);
+
+	/**
+   * Destructor of FlatBufHashTbl class
+	 */
+  ~FlatBufHashTbl();
+
+	/**
+   * Insert entry into hash table mapping (file, pageNo) to frameNo.
+	 *
+	 * @param file   	File object
+	 * @param pageNo 	Page number in the file
+	 * @param frameNo Frame number assigned to that page of the file
+   * @throws  HashAlreadyPresentException	if the corresponding page already exists in the hash table
+   * @throws  std::bad_alloc if the table had to grow and could not be allocated
+	 */
+  void insert(const File* file, const PageId pageNo, const FrameId frameNo);
+
+	/**
+   * Check if (file, pageNo) is currently in the buffer pool (ie. in
+   * the hash table) without throwing when it is not.
+	 *
+	 * @param file  	File object
+	 * @param pageNo	Page number in the file
+	 * @param frameNo Frame number reference, only assigned if the entry is found
+	 * @return  			True if the page entry is present in the hash table
+	 */
+  bool find(const File* file, const PageId pageNo, FrameId &frameNo);
+
+	/**
+   * Delete entry (file,pageNo) from hash table.
+	 *
+	 * @param file   	File object
+	 * @param pageNo  Page number in the file
+   * @throws HashNotFoundException if the page entry is not found in the hash table 
+	 */
+  void remove(const File* file, const PageId pageNo);
+
+	/**
+   * Reports the probe length distribution of the table.
+	 *
+	 * @param histogram  Filled with the comparison count histogram
+	 */
+  void probeHistogram(std::vector<std::uint32_t> &histogram) const;
+};
+
+}
@@ -0,0 +1,78 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "latch.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace badgerdb {
+
+namespace {
+
+/**
+ * A place for threads to wait for any latch that hashes to it.
+ */
+struct ParkingSlot {
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+const std::size_t NUM_PARKING_SLOTS = 64;
+
+ParkingSlot parking_slots[NUM_PARKING_SLOTS];
+
+ParkingSlot& slotFor(const void* latch) {
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(latch);
+  return parking_slots[(address >> 6) % NUM_PARKING_SLOTS];
+}
+
+}
+
+void SharedLatch::lock_shared() {
+  for (int i = 0; i < SPIN_LIMIT; ++i) {
+    if (try_lock_shared()) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  park(false);
+}
+
+void SharedLatch::lock() {
+  for (int i = 0; i < SPIN_LIMIT; ++i) {
+    if (try_lock()) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  park(true);
+}
+
+void SharedLatch::park(const bool exclusive) {
+  ParkingSlot& slot = slotFor(this);
+  std::unique_lock<std::mutex> guard(slot.mutex);
+  while (true) {
+    // Announce the waiter before the last attempt, so that a holder releasing
+    // the latch after that attempt fails is sure to wake us.
+    state_.fetch_or(WAITING, std::memory_order_relaxed);
+    if (exclusive ? try_lock() : try_lock_shared()) {
+      return;
+    }
+    slot.cond.wait(guard);
+  }
+}
+
+void SharedLatch::wakeWaiters() {
+  ParkingSlot& slot = slotFor(this);
+  std::lock_guard<std::mutex> guard(slot.mutex);
+  // Waiters that still cannot get the latch set the bit again.
+  state_.fetch_and(~WAITING, std::memory_order_relaxed);
+  slot.cond.notify_all();
+}
+
+}
@@ -0,0 +1,243 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace badgerdb {
+
+/**
+ * @brief Small mutual exclusion latch for short critical sections.
+ *
+ * A SpinLatch is a single byte, so one can be embedded in every buffer frame
+ * descriptor.  Waiters spin on a plain load and yield the processor between
+ * attempts rather than sleeping in the kernel.
+ */
+class SpinLatch {
+ public:
+  /**
+   * Constructs an unlocked latch.
+   */
+  SpinLatch()
+      : locked_(false) {
+  }
+
+  /**
+   * Acquires the latch, waiting for the current holder to release it.
+   */
+  void lock() {
+    while (!try_lock()) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /**
+   * Acquires the latch if it is free.
+   *
+   * @return  True if the latch was acquired.
+   */
+  bool try_lock() {
+    return !locked_.load(std::memory_order_relaxed) &&
+        !locked_.exchange(true, std::memory_order_acquire);
+  }
+
+  /**
+   * Releases the latch.
+   */
+  void unlock() {
+    locked_.store(false, std::memory_order_release);
+  }
+
+ private:
+  SpinLatch(const SpinLatch&);
+  SpinLatch& operator=(const SpinLatch&);
+
+  /**
+   * Whether some thread holds the latch.
+   */
+  std::atomic<bool> locked_;
+};
+
+/**
+ * @brief Reader-writer latch for the contents of a buffer frame.
+ *
+ * The latch is one 32-bit word holding the writer bit, a waiters bit and the
+ * reader count, so one fits in every frame descriptor.  Threads spin briefly
+ * and then park on a condition variable from a small pool shared by all
+ * latches, picked by the latch's address.  Writers are not given priority
+ * over readers that keep arriving.
+ *
+ * A second word counts exclusive holds, and is odd while a writer holds the
+ * latch.  Optimistic readers take a snapshot of it with readVersion(), read
+ * without latching, and keep what they read only if validate() finds the
+ * version unchanged.  They never write to the latch, so readers of a hot
+ * page do not take its cache line away from each other.
+ */
+class SharedLatch {
+ public:
+  /**
+   * Constructs an unlocked latch.
+   */
+  SharedLatch()
+      : state_(0),
+        version_(0) {
+  }
+
+  /**
+   * Acquires the latch in shared mode, waiting while a writer holds it.
+   */
+  void lock_shared();
+
+  /**
+   * Acquires the latch in shared mode if no writer holds it.
+   *
+   * @return  True if the latch was acquired.
+   */
+  bool try_lock_shared() {
+    std::uint32_t state = state_.load(std::memory_order_relaxed);
+    return (state & WRITER) == 0 &&
+        state_.compare_exchange_strong(state, state + 1,
+                                       std::memory_order_acquire);
+  }
+
+  /**
+   * Releases a shared hold on the latch.
+   */
+  void unlock_shared() {
+    if (state_.fetch_sub(1, std::memory_order_release) & WAITING) {
+      wakeWaiters();
+    }
+  }
+
+  /**
+   * Acquires the latch in exclusive mode, waiting for all holders to leave.
+   */
+  void lock();
+
+  /**
+   * Acquires the latch in exclusive mode if nobody holds it.
+   *
+   * @return  True if the latch was acquired.
+   */
+  bool try_lock() {
+    std::uint32_t state = state_.load(std::memory_order_relaxed);
+    if ((state & ~WAITING) != 0 ||
+        !state_.compare_exchange_strong(state, state | WRITER,
+                                        std::memory_order_acquire)) {
+      return false;
+    }
+    // Only the writer changes the version, so no read-modify-write is needed.
+    version_.store(version_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Releases an exclusive hold on the latch.
+   */
+  void unlock() {
+    version_.store(version_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+    if (state_.fetch_and(~WRITER, std::memory_order_release) & WAITING) {
+      wakeWaiters();
+    }
+  }
+
+  /**
+   * Starts an optimistic read, waiting while a writer holds the latch.
+   *
+   * @return  Version to pass to validate() once the read is done.
+   */
+  std::uint32_t readVersion() const {
+    std::uint32_t version;
+    while ((version = version_.load(std::memory_order_acquire)) & 1) {
+      std::this_thread::yield();
+    }
+    return version;
+  }
+
+  /**
+   * Checks that no writer held the latch since readVersion() returned the
+   * given version, in which case everything read in between is consistent.
+   *
+   * @param version  Version returned by readVersion().
+   * @return  True if the optimistic read succeeded.
+   */
+  bool validate(const std::uint32_t version) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
+ private:
+  SharedLatch(const SharedLatch&);
+  SharedLatch& operator=(const SharedLatch&);
+
+  /**
+   * Set while a writer holds the latch.
+   */
+  static const std::uint32_t WRITER = 1u << 31;
+
+  /**
+   * Set while some thread is parked waiting for the latch.
+   */
+  static const std::uint32_t WAITING = 1u << 30;
+
+  /**
+   * Number of times a waiting thread retries before it parks.
+   */
+  static const int SPIN_LIMIT = 64;
+
+  /**
+   * Parks the calling thread until the latch can be acquired in the given mode.
+   *
+   * @param exclusive  Whether the latch is wanted in exclusive mode.
+   */
+  void park(const bool exclusive);
+
+  /**
+   * Wakes the threads parked on this latch.
+   */
+  void wakeWaiters();
+
+  /**
+   * Writer bit, waiters bit and number of readers.
+   */
+  std::atomic<std::uint32_t> state_;
+
+  /**
+   * Number of times the latch was acquired or released in exclusive mode.
+   */
+  std::atomic<std::uint32_t> version_;
+};
+
+/**
+ * @brief How the buffer manager latches the contents of a page it pins.
+ */
+enum LatchMode {
+  /**
+   * Pin the page without latching it.
+   */
+  LATCH_NONE,
+
+  /**
+   * Share the page with other readers; writers wait.
+   */
+  LATCH_SHARED,
+
+  /**
+   * Keep every other latching thread away from the page.
+   */
+  LATCH_EXCLUSIVE
+};
+
+}
@@ -0,0 +1,109 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "lruKPolicy.h"
+
+namespace badgerdb {
+
+LruKPolicy::LruKPolicy(BufDesc *descs, const std::uint32_t bufs)
+	: ReplacementPolicy(descs, bufs), now(0), frameHistory(bufs), frameKeys(bufs)
+{
+}
+
+std::uint64_t LruKPolicy::priority(const AccessHistory &history)
+{
+	// pages seen once are ordered by their only access, ahead of all pages seen
+	// twice, which are ordered by the older of their two accesses
+	const std::uint64_t seenTwice = 1ULL << 62;
+	if (history.previous == 0)
+		return history.last;
+	return seenTwice + history.previous;
+}
+
+void LruKPolicy::recordAccess(const FrameId frame, const std::uint64_t time)
+{
+	AccessHistory &history = frameHistory[frame];
+	history.previous = history.last;
+	history.last = time;
+	queue.insert(std::make_pair(priority(history), frame));
+}
+
+bool LruKPolicy::applyHit(const FrameId frame)
+{
+	const std::uint64_t time = takeHit(frame);
+	if (time == 0)
+		return false;
+	queue.erase(std::make_pair(priority(frameHistory[frame]), frame));
+	recordAccess(frame, time);
+	return true;
+}
+
+void LruKPolicy::pageLoaded(const FrameId frame, const std::uint64_t pageKey)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	frameKeys[frame] = pageKey;
+	RetainedMap::iterator it = retained.find(pageKey);
+	if (it != retained.end()) {
+		// the page was replaced recently; pick up its earlier access
+		frameHistory[frame] = it->second.first;
+		retainedOrder.erase(it->second.second);
+		retained.erase(it);
+	}
+	else {
+		frameHistory[frame].last = 0;
+		frameHistory[frame].previous = 0;
+	}
+	recordAccess(frame, ++now);
+}
+
+void LruKPolicy::pagePinned(const FrameId frame)
+{
+	// hits are timed by the loads around them, so they share a time rather
+	// than each take the latch to advance it
+	noteHit(frame, now.load(std::memory_order_relaxed));
+}
+
+void LruKPolicy::pageRemoved(const FrameId frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	applyHit(frame);
+	queue.erase(std::make_pair(priority(frameHistory[frame]), frame));
+
+	// remember the history of the page, forgetting the oldest one if there are too many
+	const std::uint64_t key = frameKeys[frame];
+	RetainedMap::iterator it = retained.find(key);
+	if (it != retained.end()) {
+		retainedOrder.erase(it->second.second);
+		retained.erase(it);
+	}
+	retainedOrder.push_back(key);
+	retained[key] = std::make_pair(frameHistory[frame], --retainedOrder.end());
+	if (retained.size() > numBufs) {
+		retained.erase(retainedOrder.front());
+		retainedOrder.pop_front();
+	}
+}
+
+bool LruKPolicy::pickVictim(FrameId &frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	// a hit only ever moves a frame back in the queue, so hits are applied to
+	// the frames the scan comes across, which then come up again later on
+	for (PriorityQueue::iterator it = queue.begin(); it != queue.end(); ) {
+		const FrameId candidate = it->second;
+		++it;
+		if (applyHit(candidate))
+			continue;
+		if (isEvictable(candidate)) {
+			frame = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+}
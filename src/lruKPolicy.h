@@ -0,0 +1,123 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "replacementPolicy.h"
+
+namespace badgerdb {
+
+/**
+* @brief LRU-2 replacement: replaces the page whose second most recent access is oldest
+*
+* Pages referenced only once so far are replaced first, least recently used
+* first, so a scan that touches each page once does not push out pages that
+* are used repeatedly.  The access history of replaced pages is kept for as
+* many pages as the pool has frames, so a page that comes back soon keeps
+* its earlier access.
+*/
+class LruKPolicy : public ReplacementPolicy
+{
+ private:
+	/**
+   * The two most recent accesses to a page, in logical time; 0 if there was none
+	 */
+  struct AccessHistory {
+    std::uint64_t last;
+    std::uint64_t previous;
+  };
+
+	/**
+   * Frames holding pages ordered by priority, the page to replace first at the front
+	 */
+  typedef std::set<std::pair<std::uint64_t, FrameId> > PriorityQueue;
+
+	/**
+   * Histories of replaced pages, with their position in the order they are forgotten
+	 */
+  typedef std::unordered_map<std::uint64_t, std::pair<AccessHistory, std::list<std::uint64_t>::iterator> > RetainedMap;
+
+	/**
+   * Protects all members below
+	 */
+  std::mutex latch;
+
+	/**
+   * Logical time, advanced on every page loaded and read by hits without the latch
+	 */
+  std::atomic<std::uint64_t> now;
+
+	/**
+   * History of the page held by each frame
+	 */
+  std::vector<AccessHistory> frameHistory;
+
+	/**
+   * Key of the page held by each frame
+	 */
+  std::vector<std::uint64_t> frameKeys;
+
+	/**
+   * Frames holding pages by replacement priority
+	 */
+  PriorityQueue queue;
+
+	/**
+   * Histories of replaced pages
+	 */
+  RetainedMap retained;
+
+	/**
+   * Keys of replaced pages, oldest first
+	 */
+  std::list<std::uint64_t> retainedOrder;
+
+	/**
+   * Returns the position of a page with the given history in the priority queue.
+   * Pages with fewer than two accesses come first.
+	 */
+  static std::uint64_t priority(const AccessHistory &history);
+
+	/**
+   * Records an access at the given time to the page held by the frame, which is not in the queue.
+	 */
+  void recordAccess(const FrameId frame, const std::uint64_t time);
+
+	/**
+   * Applies the hit noted on the frame, if any, moving the frame back in the queue.
+	 *
+	 * @return  			True if there was a hit
+	 */
+  bool applyHit(const FrameId frame);
+
+ public:
+	/**
+   * Constructor of LruKPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  LruKPolicy(BufDesc *descs, const std::uint32_t bufs);
+
+  void pageLoaded(const FrameId frame, const std::uint64_t pageKey);
+
+  void pagePinned(const FrameId frame);
+
+  void pageRemoved(const FrameId frame);
+
+  bool pickVictim(FrameId &frame);
+};
+
+}
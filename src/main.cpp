@@ -2,7 +2,12 @@
 #include <stdlib.h>
 //#include <stdio.h>
 #include <cstring>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <memory>
+#include <thread>
+#include <vector>
 #include "page.h"
 #include "buffer.h"
 #include "file_iterator.h"
@@ -13,6 +18,7 @@
 #include "exceptions/page_not_pinned_exception.h"
 #include "exceptions/page_pinned_exception.h"
 #include "exceptions/buffer_exceeded_exception.h"
+#include "exceptions/invalid_record_exception.h"
 
 #define PRINT_ERROR(str)                                \
 	\
@@ -42,7 +48,29 @@ void test6();
 void test7();
 void test8();
 void test9();
-void testBufMgr();
+void test10();
+void test13();
+void test11(HashTableType tableType, ReplacementPolicyType policyType);
+void test12();
+void test14();
+void test15(ReplacementPolicyType policyType);
+void test16();
+void test17();
+void test18();
+void test19(ReplacementPolicyType policyType);
+void test20();
+void test21();
+void test22();
+void test23();
+void test24();
+void test25();
+void test26();
+void test27();
+void test28();
+void test29();
+void test30(ReplacementPolicyType policyType);
+std::streamoff fileSize(const std::string &filename);
+void testBufMgr(HashTableType tableType, ReplacementPolicyType policyType);
 
 int main()
 {
@@ -83,13 +111,15 @@ int main()
 			 iter != new_file.end();
 			 ++iter)
 		{
+			// Keep a copy of the page alive while iterating over its records.
+			Page curr_page = *iter;
 			// Iterate through all records on the page.
-			for (PageIterator page_iter = (*iter).begin();
-				 page_iter != (*iter).end();
+			for (PageIterator page_iter = curr_page.begin();
+				 page_iter != curr_page.end();
 				 ++page_iter)
 			{
 				std::cout << "Found record: " << *page_iter
-						  << " on page " << (*iter).page_number() << "\n";
+						  << " on page " << curr_page.page_number() << "\n";
 			}
 		}
 
@@ -107,14 +137,31 @@ int main()
 	// Delete the file since we're done with it.
 	File::remove(filename);
 
-	//This function tests buffer manager, comment this line if you don't wish to test buffer manager
-	testBufMgr();
+	//These tests depend on neither the hash table nor the replacement policy, so they run once
+	test20();
+	test21();
+	test22();
+	test23();
+	test24();
+	test25();
+	test26();
+	test27();
+	test28();
+	test29();
+
+	//This function tests buffer manager, comment these lines if you don't wish to test buffer manager
+	testBufMgr(CHAINED_HASH_TABLE, CLOCK_POLICY);
+	testBufMgr(FLAT_HASH_TABLE, CLOCK_POLICY);
+	testBufMgr(FLAT_HASH_TABLE, LRU_K_POLICY);
+	testBufMgr(FLAT_HASH_TABLE, TWO_Q_POLICY);
+	testBufMgr(FLAT_HASH_TABLE, ARC_POLICY);
+	testBufMgr(FLAT_HASH_TABLE, CLOCK_PRO_POLICY);
 }
 
-void testBufMgr()
+void testBufMgr(HashTableType tableType, ReplacementPolicyType policyType)
 {
 	// create buffer manager
-	bufMgr = new BufMgr(num);
+	bufMgr = new BufMgr(num, tableType, 1, policyType);
 
 	// create dummy files
 	const std::string &filename1 = "test.1";
@@ -137,40 +184,40 @@ void testBufMgr()
 	{
 	}
 	
-	File file1 = File::create(filename1);
-	File file2 = File::create(filename2);
-	File file3 = File::create(filename3);
-	File file4 = File::create(filename4);
-	File file5 = File::create(filename5);
-	File file6 = File::create(filename6);
-
-	file1ptr = &file1;
-	file2ptr = &file2;
-	file3ptr = &file3;
-	file4ptr = &file4;
-	file5ptr = &file5;
-	file6ptr = &file6;
-
-	//Test buffer manager
-	//Comment tests which you do not wish to run now. Tests are dependent on their preceding tests. So, they have to be run in the following order.
-	//Commenting  a particular test requires commenting all tests that follow it else those tests would fail.
-	test1();
-	test2();
-	test3();
-	test4();
-	test5();
-	test6();
-	test7();
-	test8();
-	test9();
-
-	//Close files before deleting them
-	file1.~File();
-	file2.~File();
-	file3.~File();
-	file4.~File();
-	file5.~File();
-	file6.~File();
+	{
+		File file1 = File::create(filename1);
+		File file2 = File::create(filename2);
+		File file3 = File::create(filename3);
+		File file4 = File::create(filename4);
+		File file5 = File::create(filename5);
+		File file6 = File::create(filename6);
+
+		file1ptr = &file1;
+		file2ptr = &file2;
+		file3ptr = &file3;
+		file4ptr = &file4;
+		file5ptr = &file5;
+		file6ptr = &file6;
+
+		//Test buffer manager
+		//Comment tests which you do not wish to run now. Tests are dependent on their preceding tests. So, they have to be run in the following order.
+		//Commenting  a particular test requires commenting all tests that follow it else those tests would fail.
+		test1();
+		test2();
+		test3();
+		test4();
+		test5();
+		test6();
+		test7();
+		test8();
+		test9();
+		test10();
+		test13();
+
+		//Write back dirty pages while the files are still open
+		delete bufMgr;
+	}
+	//Files are closed once they go out of scope, so they can be deleted now
 
 	//Delete files
 	File::remove(filename1);
@@ -180,7 +227,18 @@ void testBufMgr()
 	File::remove(filename5);
 	File::remove(filename6);
 
-	delete bufMgr;
+	test11(tableType, policyType);
+	test12();
+	test14();
+	if (policyType != CLOCK_POLICY)
+	{
+		test15(policyType);
+		test30(policyType);
+	}
+	test16();
+	test17();
+	test18();
+	test19(policyType);
 
 	std::cout << "\n"
 			  << "Passed all tests."
@@ -430,3 +488,1625 @@ void test9()
 	std::cout << "Test 9 passed"
 			  << "\n";
 }
+
+void test10()
+{
+	//evicting a file drops its pages from the buffer without writing them back
+	for (i = 0; i < num; i++)
+	{
+		bufMgr->allocPage(file6ptr, pid[i], page);
+		sprintf((char *)tmpbuf, "test.6 Page %d %7.1f", pid[i], (float)pid[i]);
+		rid[i] = page->insertRecord(tmpbuf);
+	}
+
+	try
+	{
+		bufMgr->evictFile(file6ptr);
+		PRINT_ERROR("ERROR :: Pages pinned for file being evicted. Exception should have been thrown before execution reaches this point.");
+	}
+	catch (PagePinnedException e)
+	{
+	}
+
+	for (i = 0; i < num; i++)
+		bufMgr->unPinPage(file6ptr, pid[i], true);
+	bufMgr->evictFile(file6ptr);
+
+	for (i = 0; i < num; i++)
+	{
+		bufMgr->readPage(file6ptr, pid[i], page);
+		try
+		{
+			page->getRecord(rid[i]);
+			PRINT_ERROR("ERROR :: Record should have been discarded along with the evicted page.");
+		}
+		catch (InvalidRecordException e)
+		{
+		}
+		bufMgr->unPinPage(file6ptr, pid[i], false);
+	}
+
+	std::cout << "Test 10 passed"
+			  << "\n";
+}
+
+const int threadCount = 8;
+const PageId pagesPerThread = 16;
+const PageId sharedPages = 32;
+const int rounds = 200;
+
+void test11Worker(BufMgr *mgr, File *file, int thread, const std::vector<PageId> *ownPages,
+									const std::vector<RecordId> *ownRids, const std::vector<PageId> *readPages,
+									const std::vector<RecordId> *readRids, bool *failed)
+{
+	Page *p;
+	char buf[100];
+	unsigned int seed = thread;
+	for (int round = 1; round <= rounds && !*failed; round++)
+	{
+		//update the pages only this thread writes to
+		for (std::size_t j = 0; j < ownPages->size(); j++)
+		{
+			mgr->readPage(file, (*ownPages)[j], p, LATCH_EXCLUSIVE);
+			sprintf(buf, "test.7 Page %d round %5d", (*ownPages)[j], round);
+			p->updateRecord((*ownRids)[j], buf);
+			mgr->unPinPage(file, (*ownPages)[j], true, LATCH_EXCLUSIVE);
+		}
+
+		//read pages every thread reads but none writes to
+		for (int j = 0; j < 8; j++)
+		{
+			std::size_t index = rand_r(&seed) % readPages->size();
+			mgr->readPage(file, (*readPages)[index], p, LATCH_SHARED);
+			sprintf(buf, "test.7 Page %d shared", (*readPages)[index]);
+			if (strncmp(p->getRecord((*readRids)[index]).c_str(), buf, strlen(buf)) != 0)
+				*failed = true;
+			mgr->unPinPage(file, (*readPages)[index], false, LATCH_SHARED);
+		}
+	}
+}
+
+void test11(HashTableType tableType, ReplacementPolicyType policyType)
+{
+	//many threads share a pool that is much smaller than the pages they use
+	const std::string &filename7 = "test.7";
+	try
+	{
+		File::remove(filename7);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file7 = File::create(filename7);
+		BufMgr *mgr = new BufMgr(threadCount * 4, tableType, 8, policyType);
+		std::vector<std::vector<PageId> > ownPages(threadCount);
+		std::vector<std::vector<RecordId> > ownRids(threadCount);
+		std::vector<PageId> readPages;
+		std::vector<RecordId> readRids;
+
+		for (i = 0; i < sharedPages; i++)
+		{
+			mgr->allocPage(&file7, pageno1, page);
+			sprintf((char *)tmpbuf, "test.7 Page %d shared", pageno1);
+			readPages.push_back(pageno1);
+			readRids.push_back(page->insertRecord(tmpbuf));
+			mgr->unPinPage(&file7, pageno1, true);
+		}
+		for (int t = 0; t < threadCount; t++)
+		{
+			for (i = 0; i < pagesPerThread; i++)
+			{
+				mgr->allocPage(&file7, pageno1, page);
+				sprintf((char *)tmpbuf, "test.7 Page %d round %5d", pageno1, 0);
+				ownPages[t].push_back(pageno1);
+				ownRids[t].push_back(page->insertRecord(tmpbuf));
+				mgr->unPinPage(&file7, pageno1, true);
+			}
+		}
+
+		bool failed[threadCount] = {false};
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+			threads.push_back(std::thread(test11Worker, mgr, &file7, t, &ownPages[t], &ownRids[t],
+																		&readPages, &readRids, &failed[t]));
+		for (int t = 0; t < threadCount; t++)
+			threads[t].join();
+		for (int t = 0; t < threadCount; t++)
+		{
+			if (failed[t])
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+
+		//every thread's last update has to reach the file
+		mgr->flushFile(&file7);
+		for (int t = 0; t < threadCount; t++)
+		{
+			for (i = 0; i < pagesPerThread; i++)
+			{
+				Page check = file7.readPage(ownPages[t][i]);
+				sprintf((char *)tmpbuf, "test.7 Page %d round %5d", ownPages[t][i], rounds);
+				if (strncmp(check.getRecord(ownRids[t][i]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+				{
+					PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+				}
+			}
+		}
+		delete mgr;
+	}
+	File::remove(filename7);
+
+	std::cout << "Test 11 passed"
+			  << "\n";
+}
+
+const int hotIncrements = 2000;
+
+void test12Worker(BufMgr *mgr, File *file, PageId hotPage, RecordId hotRid, const Page *pinned, bool *failed)
+{
+	Page *p;
+	char buf[100];
+	for (int n = 0; n < hotIncrements; n++)
+	{
+		//optimistic readers keep only what they read while no writer held the page
+		std::string record;
+		std::uint32_t version;
+		do
+		{
+			version = mgr->beginOptimisticRead(pinned);
+			try
+			{
+				record = pinned->getRecord(hotRid);
+			}
+			catch (...)
+			{
+			}
+		} while (!mgr->validateOptimisticRead(pinned, version));
+		int optimistic = 0;
+		if (sscanf(record.c_str(), "test.8 counter %d", &optimistic) != 1)
+			*failed = true;
+
+		//readers may share the page, but must never see a half written counter
+		mgr->readPage(file, hotPage, p, LATCH_SHARED);
+		int seen = 0;
+		if (sscanf(p->getRecord(hotRid).c_str(), "test.8 counter %d", &seen) != 1)
+			*failed = true;
+		mgr->unPinPage(file, hotPage, false, LATCH_SHARED);
+
+		mgr->readPage(file, hotPage, p, LATCH_EXCLUSIVE);
+		int count = 0;
+		sscanf(p->getRecord(hotRid).c_str(), "test.8 counter %d", &count);
+		sprintf(buf, "test.8 counter %d", count + 1);
+		p->updateRecord(hotRid, buf);
+		mgr->unPinPage(file, hotPage, true, LATCH_EXCLUSIVE);
+	}
+}
+
+void test12()
+{
+	//threads that latch one hot page exclusively never lose each other's updates,
+	//and readers sharing it, latched or optimistic, never see a half written one
+	const std::string &filename8 = "test.8";
+	try
+	{
+		File::remove(filename8);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file8 = File::create(filename8);
+		BufMgr *mgr = new BufMgr(threadCount, FLAT_HASH_TABLE, 4);
+		PageId hotPage;
+		mgr->allocPage(&file8, hotPage, page);
+		RecordId hotRid = page->insertRecord("test.8 counter 0");
+		//the page stays pinned for the optimistic readers
+
+		bool failed[threadCount] = {false};
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+			threads.push_back(std::thread(test12Worker, mgr, &file8, hotPage, hotRid, page, &failed[t]));
+		for (int t = 0; t < threadCount; t++)
+			threads[t].join();
+		mgr->unPinPage(&file8, hotPage, true);
+		for (int t = 0; t < threadCount; t++)
+		{
+			if (failed[t])
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+
+		mgr->readPage(&file8, hotPage, page);
+		sprintf((char *)tmpbuf, "test.8 counter %d", threadCount * hotIncrements);
+		if (page->getRecord(hotRid) != tmpbuf)
+		{
+			PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+		mgr->unPinPage(&file8, hotPage, false);
+		delete mgr;
+	}
+	File::remove(filename8);
+
+	std::cout << "Test 12 passed"
+			  << "\n";
+}
+
+void test13()
+{
+	//page guards unpin the pages they hold, also when an exception unwinds past them
+	for (i = 0; i < num; i++)
+	{
+		PageGuard guard = bufMgr->fetchPage(file6ptr, pid[i]);
+		sprintf((char *)tmpbuf, "test.6 Page %d guarded", pid[i]);
+		rid[i] = guard->insertRecord(tmpbuf);
+		guard.markDirty();
+	}
+
+	try
+	{
+		PageGuard guard = bufMgr->fetchPage(file6ptr, pid[0], LATCH_EXCLUSIVE);
+		PageGuard moved = std::move(guard);
+		if (guard.holdsPage() || !moved.holdsPage())
+		{
+			PRINT_ERROR("ERROR :: Moving a page guard should hand over its page.");
+		}
+		moved->getRecord(rid[1]);
+		PRINT_ERROR("ERROR :: Looking up a record of another page should have thrown.");
+	}
+	catch (InvalidRecordException e)
+	{
+	}
+
+	PageId newPageNo;
+	{
+		PageGuard guard = bufMgr->newPage(file6ptr, newPageNo);
+		guard->insertRecord("test.6 new guarded page");
+		guard.markDirty();
+		guard.release();
+		if (guard.holdsPage())
+		{
+			PRINT_ERROR("ERROR :: A released page guard should hold no page.");
+		}
+	}
+
+	//no guard left a page pinned, and every dirty page is written back
+	bufMgr->flushFile(file6ptr);
+	for (i = 0; i < num; i++)
+	{
+		Page check = file6ptr->readPage(pid[i]);
+		sprintf((char *)tmpbuf, "test.6 Page %d guarded", pid[i]);
+		if (check.getRecord(rid[i]) != tmpbuf)
+		{
+			PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+	}
+
+	std::cout << "Test 13 passed"
+			  << "\n";
+}
+
+const PageId coalescedPages = 16;
+
+void test14Worker(BufMgr *mgr, File *file, const std::vector<PageId> *pages, const std::vector<RecordId> *rids,
+									PageId badPage, std::atomic<int> *ready, bool *failed)
+{
+	Page *p;
+	char buf[100];
+	//start together so that the threads miss on the same pages at the same time
+	ready->fetch_add(1);
+	while (*ready < threadCount)
+		std::this_thread::yield();
+
+	for (std::size_t j = 0; j < pages->size(); j++)
+	{
+		mgr->readPage(file, (*pages)[j], p, LATCH_SHARED);
+		sprintf(buf, "test.9 Page %d", (*pages)[j]);
+		if (p->getRecord((*rids)[j]) != buf)
+			*failed = true;
+		mgr->unPinPage(file, (*pages)[j], false, LATCH_SHARED);
+	}
+
+	//every thread that waited on a failed read tries it again and sees the error itself
+	try
+	{
+		mgr->readPage(file, badPage, p);
+		*failed = true;
+	}
+	catch (InvalidPageException e)
+	{
+	}
+}
+
+void test14()
+{
+	//threads missing on the same page at once read it from disk only once
+	const std::string &filename9 = "test.9";
+	try
+	{
+		File::remove(filename9);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file9 = File::create(filename9);
+		std::vector<PageId> pages;
+		std::vector<RecordId> rids;
+		for (i = 0; i < coalescedPages; i++)
+		{
+			Page new_page = file9.allocatePage();
+			sprintf((char *)tmpbuf, "test.9 Page %d", new_page.page_number());
+			rids.push_back(new_page.insertRecord(tmpbuf));
+			pages.push_back(new_page.page_number());
+			file9.writePage(new_page);
+		}
+		PageId badPage = file9.allocatePage().page_number();
+		file9.deletePage(badPage);
+
+		//leave a frame per thread for misses that lose the race, so no page is evicted
+		BufMgr *mgr = new BufMgr(coalescedPages + threadCount, FLAT_HASH_TABLE, 4);
+		std::atomic<int> ready(0);
+		bool failed[threadCount] = {false};
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+			threads.push_back(std::thread(test14Worker, mgr, &file9, &pages, &rids, badPage, &ready, &failed[t]));
+		for (int t = 0; t < threadCount; t++)
+			threads[t].join();
+		for (int t = 0; t < threadCount; t++)
+		{
+			if (failed[t])
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+		if (mgr->getBufStats().diskreads != (int)coalescedPages)
+		{
+			PRINT_ERROR("ERROR :: Each page should have been read from disk exactly once.");
+		}
+
+		//failed reads gave their frames back, so every frame can be pinned at once
+		for (int t = 0; t < threadCount; t++)
+		{
+			mgr->allocPage(&file9, pageno1, page);
+			pages.push_back(pageno1);
+		}
+		for (i = 0; i < coalescedPages; i++)
+			mgr->readPage(&file9, pages[i], page);
+		for (i = 0; i < pages.size(); i++)
+			mgr->unPinPage(&file9, pages[i], false);
+		delete mgr;
+	}
+	File::remove(filename9);
+
+	std::cout << "Test 14 passed"
+			  << "\n";
+}
+
+void test15(ReplacementPolicyType policyType)
+{
+	//pages used repeatedly survive a scan of more pages than the pool holds
+	const std::string &filename10 = "test.10";
+	const PageId poolSize = 8;
+	const PageId hotPages = 3;
+	const PageId coldPages = 24;
+	try
+	{
+		File::remove(filename10);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file10 = File::create(filename10);
+		for (i = 0; i < hotPages + coldPages; i++)
+			file10.writePage(file10.allocatePage());
+
+		BufMgr *mgr = new BufMgr(poolSize, FLAT_HASH_TABLE, 1, policyType);
+		//touch the hot pages, let a few other pages push them out, and use them twice more
+		for (i = 1; i <= hotPages; i++)
+		{
+			mgr->readPage(&file10, i, page);
+			mgr->unPinPage(&file10, i, false);
+		}
+		for (i = hotPages + 1; i <= hotPages + poolSize; i++)
+		{
+			mgr->readPage(&file10, i, page);
+			mgr->unPinPage(&file10, i, false);
+		}
+		for (int round = 0; round < 2; round++)
+		{
+			for (i = 1; i <= hotPages; i++)
+			{
+				mgr->readPage(&file10, i, page);
+				mgr->unPinPage(&file10, i, false);
+			}
+		}
+
+		//scan the rest of the file once
+		for (i = hotPages + poolSize + 1; i <= hotPages + coldPages; i++)
+		{
+			mgr->readPage(&file10, i, page);
+			mgr->unPinPage(&file10, i, false);
+		}
+
+		const int readsBefore = mgr->getBufStats().diskreads;
+		for (i = 1; i <= hotPages; i++)
+		{
+			mgr->readPage(&file10, i, page);
+			mgr->unPinPage(&file10, i, false);
+		}
+		if (mgr->getBufStats().diskreads != readsBefore)
+		{
+			PRINT_ERROR("ERROR :: Hot pages should have stayed in the buffer pool during the scan.");
+		}
+		delete mgr;
+	}
+	File::remove(filename10);
+
+	std::cout << "Test 15 passed"
+			  << "\n";
+}
+
+void test16()
+{
+	//a scan and a bulk load through a ring of frames leave the rest of the pool alone
+	const std::string &filename11 = "test.11";
+	const std::uint32_t poolSize = 64;
+	const std::uint32_t ringSize = 4;
+	const PageId hotPages = 16;
+	const PageId scanPages = 200;
+	const PageId loadPages = 100;
+	try
+	{
+		File::remove(filename11);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file11 = File::create(filename11);
+		for (i = 0; i < hotPages + scanPages; i++)
+			file11.writePage(file11.allocatePage());
+
+		BufMgr *mgr = new BufMgr(poolSize);
+		for (i = 1; i <= hotPages; i++)
+		{
+			mgr->readPage(&file11, i, page);
+			mgr->unPinPage(&file11, i, false);
+		}
+
+		BufAccessStrategy scan(ringSize);
+		for (i = hotPages + 1; i <= hotPages + scanPages; i++)
+		{
+			mgr->readPage(&file11, i, page, LATCH_NONE, &scan);
+			mgr->unPinPage(&file11, i, false);
+		}
+		if (scan.reusedFrames() != scanPages - ringSize)
+		{
+			PRINT_ERROR("ERROR :: The scan should have kept reusing the frames of its ring.");
+		}
+
+		//the load writes back its own pages as it reuses their frames
+		BufAccessStrategy load(ringSize);
+		const int writesBefore = mgr->getBufStats().diskwrites;
+		for (i = 0; i < loadPages; i++)
+		{
+			mgr->allocPage(&file11, pageno1, page, &load);
+			page->insertRecord("bulk loaded");
+			mgr->unPinPage(&file11, pageno1, true);
+		}
+		if (mgr->getBufStats().diskwrites - writesBefore != (int)(loadPages - ringSize))
+		{
+			PRINT_ERROR("ERROR :: The load should have written back every page whose frame it reused.");
+		}
+
+		const int readsBefore = mgr->getBufStats().diskreads;
+		for (i = 1; i <= hotPages; i++)
+		{
+			mgr->readPage(&file11, i, page);
+			mgr->unPinPage(&file11, i, false);
+		}
+		if (mgr->getBufStats().diskreads != readsBefore)
+		{
+			PRINT_ERROR("ERROR :: Pages read before the scan should have stayed in the buffer pool.");
+		}
+		delete mgr;
+	}
+	File::remove(filename11);
+
+	std::cout << "Test 16 passed"
+			  << "\n";
+}
+
+void test17()
+{
+	//misses in page order read the following pages along with them
+	const std::string &filename12 = "test.12";
+	const std::uint32_t poolSize = 128;
+	const PageId filePages = 64;
+	try
+	{
+		File::remove(filename12);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file12 = File::create(filename12);
+		std::vector<RecordId> rids;
+		for (i = 1; i <= filePages; i++)
+		{
+			Page newPage = file12.allocatePage();
+			sprintf((char*)tmpbuf, "test.12 Page %d %7.1f", i, (float)i);
+			rids.push_back(newPage.insertRecord(tmpbuf));
+			file12.writePage(newPage);
+		}
+
+		BufMgr *mgr = new BufMgr(poolSize);
+		for (i = 1; i <= filePages; i++)
+		{
+			mgr->readPage(&file12, i, page);
+			sprintf((char*)&tmpbuf, "test.12 Page %d %7.1f", i, (float)i);
+			if (strncmp(page->getRecord(rids[i - 1]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+			}
+			mgr->unPinPage(&file12, i, false);
+		}
+		BufStats &stats = mgr->getBufStats();
+		if (stats.diskreads != (int)filePages || stats.prefetched == 0)
+		{
+			PRINT_ERROR("ERROR :: Pages should have been read ahead, each of them once.");
+		}
+		if (stats.prefetchHits != stats.prefetched || stats.prefetchWasted != 0)
+		{
+			PRINT_ERROR("ERROR :: Every page read ahead should have been used.");
+		}
+
+		//a file advised to be read at random is never read ahead
+		mgr->evictFile(&file12);
+		mgr->adviseAccess(&file12, ACCESS_RANDOM);
+		mgr->clearBufStats();
+		for (i = 1; i <= filePages; i++)
+		{
+			mgr->readPage(&file12, i, page);
+			mgr->unPinPage(&file12, i, false);
+		}
+		if (stats.prefetched != 0 || stats.diskreads != (int)filePages)
+		{
+			PRINT_ERROR("ERROR :: A file read at random should not have been read ahead.");
+		}
+
+		//a file advised to be read in order is read ahead from the first miss
+		mgr->evictFile(&file12);
+		mgr->adviseAccess(&file12, ACCESS_SEQUENTIAL);
+		mgr->clearBufStats();
+		mgr->readPage(&file12, 1, page);
+		mgr->unPinPage(&file12, 1, false);
+		const int prefetched = stats.prefetched;
+		if (prefetched == 0)
+		{
+			PRINT_ERROR("ERROR :: A file read in order should have been read ahead on the first miss.");
+		}
+		mgr->evictFile(&file12);
+		if (stats.prefetchWasted != prefetched)
+		{
+			PRINT_ERROR("ERROR :: Pages read ahead and never used should have been counted as wasted.");
+		}
+
+		//a page already in the buffer pool ends the read ahead, so no copy of it is read from disk
+		mgr->readPage(&file12, 3, page);
+		const RecordId updated = page->insertRecord("test.12 updated");
+		mgr->unPinPage(&file12, 3, true);
+		mgr->clearBufStats();
+		mgr->readPage(&file12, 1, page);
+		mgr->unPinPage(&file12, 1, false);
+		if (stats.diskreads != 2)
+		{
+			PRINT_ERROR("ERROR :: Read ahead should have stopped at the page in the buffer pool.");
+		}
+		mgr->readPage(&file12, 3, page);
+		if (page->getRecord(updated) != "test.12 updated")
+		{
+			PRINT_ERROR("ERROR :: Read ahead should not have replaced a page in the buffer pool.");
+		}
+		mgr->unPinPage(&file12, 3, false);
+		delete mgr;
+	}
+	File::remove(filename12);
+
+	std::cout << "Test 17 passed"
+			  << "\n";
+}
+
+void test18()
+{
+	//a batch of pages is read with one read per run of consecutive pages
+	const std::string &filename13 = "test.13";
+	const std::uint32_t poolSize = 32;
+	const PageId filePages = 40;
+	try
+	{
+		File::remove(filename13);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file13 = File::create(filename13);
+		std::vector<RecordId> rids;
+		for (i = 1; i <= filePages; i++)
+		{
+			Page newPage = file13.allocatePage();
+			sprintf((char*)tmpbuf, "test.13 Page %d %7.1f", i, (float)i);
+			rids.push_back(newPage.insertRecord(tmpbuf));
+			file13.writePage(newPage);
+		}
+
+		BufMgr *mgr = new BufMgr(poolSize);
+		BufStats &stats = mgr->getBufStats();
+		const PageId batch[] = {10, 3, 4, 5, 30, 11, 12, 4};
+		const std::vector<PageId> pageNos(batch, batch + 8);
+		std::vector<Page*> pages;
+		mgr->readPages(&file13, pageNos, pages);
+		for (std::size_t k = 0; k < pageNos.size(); k++)
+		{
+			sprintf((char*)&tmpbuf, "test.13 Page %d %7.1f", pageNos[k], (float)pageNos[k]);
+			if (strncmp(pages[k]->getRecord(rids[pageNos[k] - 1]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+			}
+		}
+		if (pages[2] != pages[7] || stats.diskreads != 7)
+		{
+			PRINT_ERROR("ERROR :: Every page of the batch should have been read once.");
+		}
+		for (std::size_t k = 0; k < pageNos.size(); k++)
+			mgr->unPinPage(&file13, pageNos[k], false);
+
+		//pages brought in ahead of time are found without reading them again
+		const PageId wanted[] = {20, 21, 22, 25, 26, 99};
+		mgr->prefetch(&file13, std::vector<PageId>(wanted, wanted + 6));
+		if (stats.prefetched != 5 || stats.diskreads != 12)
+		{
+			PRINT_ERROR("ERROR :: The pages in the file should have been prefetched.");
+		}
+		mgr->readPage(&file13, 21, page);
+		mgr->unPinPage(&file13, 21, false);
+		if (stats.diskreads != 12 || stats.prefetchHits != 1)
+		{
+			PRINT_ERROR("ERROR :: A prefetched page should have been found in the buffer pool.");
+		}
+
+		//a page not in the file fails the batch and leaves nothing pinned
+		const PageId invalid[] = {2, 99, 1};
+		try
+		{
+			mgr->readPages(&file13, std::vector<PageId>(invalid, invalid + 3), pages);
+			PRINT_ERROR("ERROR :: Page is not in the file. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		mgr->flushFile(&file13);
+		delete mgr;
+	}
+	File::remove(filename13);
+
+	std::cout << "Test 18 passed"
+			  << "\n";
+}
+
+void test19(ReplacementPolicyType policyType)
+{
+	//the background writer cleans dirty pages before a miss has to write them out
+	const std::string &filename14 = "test.14";
+	const std::uint32_t poolSize = 16;
+	const PageId extraPages = 9;
+	try
+	{
+		File::remove(filename14);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file14 = File::create(filename14);
+		for (i = 0; i < extraPages; i++)
+			file14.writePage(file14.allocatePage());
+
+		BufMgr *mgr = new BufMgr(poolSize, FLAT_HASH_TABLE, 1, policyType);
+		BufStats &stats = mgr->getBufStats();
+		std::vector<RecordId> rids;
+		for (i = 0; i < poolSize; i++)
+		{
+			mgr->allocPage(&file14, pid[i], page);
+			sprintf((char*)tmpbuf, "test.14 Page %d %7.1f", pid[i], (float)pid[i]);
+			rids.push_back(page->insertRecord(tmpbuf));
+			mgr->unPinPage(&file14, pid[i], true);
+		}
+
+		//one miss writes its victim out itself
+		mgr->readPage(&file14, 1, page);
+		mgr->unPinPage(&file14, 1, false);
+		if (stats.fgwrites != 1)
+		{
+			PRINT_ERROR("ERROR :: The page replaced should have been written out by the miss.");
+		}
+
+		mgr->startBgWriter(BgWriterConfig(poolSize, poolSize, 1));
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (stats.bgwrites < (int)poolSize - 1 && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		mgr->stopBgWriter();
+		if (stats.bgwrites != (int)poolSize - 1)
+		{
+			PRINT_ERROR("ERROR :: The background writer should have written every dirty page.");
+		}
+
+		//what the background writer wrote is on disk
+		for (i = 1; i < poolSize; i++)
+		{
+			Page onDisk = file14.readPage(pid[i]);
+			sprintf((char*)&tmpbuf, "test.14 Page %d %7.1f", pid[i], (float)pid[i]);
+			if (strncmp(onDisk.getRecord(rids[i]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+			}
+		}
+
+		//and misses find clean victims
+		for (i = 2; i <= extraPages; i++)
+		{
+			mgr->readPage(&file14, i, page);
+			mgr->unPinPage(&file14, i, false);
+		}
+		if (stats.fgwrites != 1)
+		{
+			PRINT_ERROR("ERROR :: The pages replaced should have been clean.");
+		}
+		delete mgr;
+	}
+	File::remove(filename14);
+
+	std::cout << "Test 19 passed"
+			  << "\n";
+}
+
+void test20()
+{
+	//flushFile writes dirty pages in file order and keeps the used page list intact
+	const std::string &filename15 = "test.15";
+	const PageId filePages = 12;
+	const PageId cleanPage = 6;
+	try
+	{
+		File::remove(filename15);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file15 = File::create(filename15);
+		for (i = 0; i < filePages; i++)
+			file15.writePage(file15.allocatePage());
+
+		BufMgr *mgr = new BufMgr(2 * filePages);
+		BufStats &stats = mgr->getBufStats();
+		std::vector<RecordId> rids(filePages + 1);
+		//dirty the pages back to front, leaving a gap so they go out in two runs
+		for (PageId pageNo = filePages; pageNo >= 1; pageNo--)
+		{
+			mgr->readPage(&file15, pageNo, page);
+			if (pageNo != cleanPage)
+			{
+				sprintf((char*)tmpbuf, "test.15 Page %d %7.1f", pageNo, (float)pageNo);
+				rids[pageNo] = page->insertRecord(tmpbuf);
+			}
+			mgr->unPinPage(&file15, pageNo, pageNo != cleanPage);
+		}
+
+		const int writesBefore = stats.diskwrites;
+		mgr->flushFile(&file15);
+		if (stats.diskwrites - writesBefore != (int)filePages - 1)
+		{
+			PRINT_ERROR("ERROR :: flushFile should have written each dirty page once.");
+		}
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+		{
+			if (pageNo == cleanPage)
+				continue;
+			Page onDisk = file15.readPage(pageNo);
+			sprintf((char*)&tmpbuf, "test.15 Page %d %7.1f", pageNo, (float)pageNo);
+			if (strncmp(onDisk.getRecord(rids[pageNo]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+			}
+		}
+		PageId usedPages = 0;
+		for (FileIterator iter = file15.begin(); iter != file15.end(); ++iter)
+			usedPages++;
+		if (usedPages != filePages)
+		{
+			PRINT_ERROR("ERROR :: Writing the pages back broke the list of used pages.");
+		}
+
+		//a page deleted from the file behind the buffer's back stays dirty when its write fails
+		mgr->readPage(&file15, 3, page);
+		page->insertRecord("test.15 deleted");
+		mgr->unPinPage(&file15, 3, true);
+		file15.deletePage(3);
+		try
+		{
+			mgr->flushFile(&file15);
+			PRINT_ERROR("ERROR :: Flushing a deleted page should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		mgr->evictFile(&file15);
+		delete mgr;
+	}
+	File::remove(filename15);
+
+	std::cout << "Test 20 passed"
+			  << "\n";
+}
+
+void test21()
+{
+	//flushDirty writes dirty pages out while they are in use and keeps them resident
+	const std::string &filename16 = "test.16";
+	const PageId filePages = 3;
+	try
+	{
+		File::remove(filename16);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file16 = File::create(filename16);
+		for (i = 0; i < filePages; i++)
+			file16.writePage(file16.allocatePage());
+
+		BufMgr *mgr = new BufMgr(num);
+		BufStats &stats = mgr->getBufStats();
+		std::vector<RecordId> rids(filePages + 1);
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+		{
+			mgr->readPage(&file16, pageNo, page);
+			sprintf((char*)tmpbuf, "test.16 Page %d %7.1f", pageNo, (float)pageNo);
+			rids[pageNo] = page->insertRecord(tmpbuf);
+			mgr->unPinPage(&file16, pageNo, true);
+		}
+
+		//page 2 stays pinned and page 3 is latched for writing
+		mgr->readPage(&file16, 2, page);
+		PageGuard guard = mgr->fetchPage(&file16, 3, LATCH_EXCLUSIVE);
+		const int readsBefore = stats.diskreads;
+		if (mgr->flushDirty(&file16) != 2)
+		{
+			PRINT_ERROR("ERROR :: flushDirty should have written the unlatched dirty pages.");
+		}
+		for (PageId pageNo = 1; pageNo <= 2; pageNo++)
+		{
+			Page onDisk = file16.readPage(pageNo);
+			sprintf((char*)&tmpbuf, "test.16 Page %d %7.1f", pageNo, (float)pageNo);
+			if (strncmp(onDisk.getRecord(rids[pageNo]).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+			}
+		}
+
+		guard.release();
+		if (mgr->flushDirty(&file16) != 1)
+		{
+			PRINT_ERROR("ERROR :: The page latched during the first flush should still have been dirty.");
+		}
+		if (mgr->flushDirty(&file16) != 0)
+		{
+			PRINT_ERROR("ERROR :: Flushed pages should be clean.");
+		}
+
+		//the pages never left the buffer pool
+		mgr->unPinPage(&file16, 2, false);
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+		{
+			mgr->readPage(&file16, pageNo, page);
+			mgr->unPinPage(&file16, pageNo, false);
+		}
+		if (stats.diskreads != readsBefore)
+		{
+			PRINT_ERROR("ERROR :: flushDirty should not have evicted any page.");
+		}
+		delete mgr;
+	}
+	File::remove(filename16);
+
+	std::cout << "Test 21 passed"
+			  << "\n";
+}
+
+void test22Worker(File file, const std::vector<PageId> *ownPages, const std::vector<RecordId> *ownRids,
+									const PageId sharedFirst, const PageId sharedCount, bool *failed)
+{
+	//each thread has its own File object, all of them sharing one descriptor
+	char buf[100];
+	for (int n = 1; n <= rounds; n++)
+	{
+		for (std::size_t j = 0; j < ownPages->size(); j++)
+		{
+			Page own = file.readPage((*ownPages)[j]);
+			sprintf(buf, "test.17 Page %d round %5d", (*ownPages)[j], n - 1);
+			if (own.getRecord((*ownRids)[j]) != buf)
+				*failed = true;
+			sprintf(buf, "test.17 Page %d round %5d", (*ownPages)[j], n);
+			own.updateRecord((*ownRids)[j], buf);
+			file.writePage(own);
+		}
+		std::vector<Page> shared = file.readPages(sharedFirst, sharedCount);
+		if (shared.size() != sharedCount)
+			*failed = true;
+		for (std::size_t j = 0; j < shared.size(); j++)
+		{
+			sprintf(buf, "test.17 Page %d shared", shared[j].page_number());
+			if (shared[j].page_number() != sharedFirst + j || (*shared[j].begin()).compare(0, strlen(buf), buf) != 0)
+				*failed = true;
+		}
+	}
+}
+
+void test22()
+{
+	//page reads and writes through one file from many threads
+	const std::string &filename17 = "test.17";
+	const PageId sharedCount = 8;
+	try
+	{
+		File::remove(filename17);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file17 = File::create(filename17);
+		for (i = 0; i < sharedCount; i++)
+		{
+			Page shared = file17.allocatePage();
+			sprintf((char *)tmpbuf, "test.17 Page %d shared", shared.page_number());
+			shared.insertRecord(tmpbuf);
+			file17.writePage(shared);
+		}
+		std::vector<std::vector<PageId> > ownPages(threadCount);
+		std::vector<std::vector<RecordId> > ownRids(threadCount);
+		for (int t = 0; t < threadCount; t++)
+		{
+			for (i = 0; i < 4; i++)
+			{
+				Page own = file17.allocatePage();
+				sprintf((char *)tmpbuf, "test.17 Page %d round %5d", own.page_number(), 0);
+				ownPages[t].push_back(own.page_number());
+				ownRids[t].push_back(own.insertRecord(tmpbuf));
+				file17.writePage(own);
+			}
+		}
+
+		bool failed[threadCount] = {false};
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+			threads.push_back(std::thread(test22Worker, file17, &ownPages[t], &ownRids[t], 1, sharedCount, &failed[t]));
+		for (int t = 0; t < threadCount; t++)
+			threads[t].join();
+		for (int t = 0; t < threadCount; t++)
+		{
+			if (failed[t])
+				PRINT_ERROR("ERROR :: CONTENTS DID NOT MATCH");
+		}
+	}
+	File::remove(filename17);
+
+	std::cout << "Test 22 passed"
+			  << "\n";
+}
+
+void test23()
+{
+	//File objects for one file share the header kept in memory, and it reaches the disk
+	const std::string &filename18 = "test.18";
+	try
+	{
+		File::remove(filename18);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	PageId first, second, third;
+	{
+		File file18 = File::create(filename18);
+		first = file18.allocatePage().page_number();
+		File other = File::open(filename18);
+		second = other.allocatePage().page_number();
+		//each object sees the page the other allocated
+		file18.readPage(second);
+		other.readPage(first);
+		third = file18.allocatePage().page_number();
+		file18.deletePage(first);
+		PageId usedPages = 0;
+		for (FileIterator iter = other.begin(); iter != other.end(); ++iter)
+			usedPages++;
+		if (usedPages != 2)
+		{
+			PRINT_ERROR("ERROR :: Both File objects should see the same used pages.");
+		}
+	}
+	{
+		//the header written while the file was open is read back when it is opened again
+		File file18 = File::open(filename18);
+		file18.readPage(second);
+		file18.readPage(third);
+		try
+		{
+			file18.readPage(third + 1);
+			PRINT_ERROR("ERROR :: Reading past the last page should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		try
+		{
+			file18.readPage(Page::INVALID_NUMBER);
+			PRINT_ERROR("ERROR :: Reading the invalid page number should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		try
+		{
+			file18.readPages(Page::INVALID_NUMBER, 2);
+			PRINT_ERROR("ERROR :: Reading from the invalid page number should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		if (file18.allocatePage().page_number() != first)
+		{
+			PRINT_ERROR("ERROR :: The deleted page should have been reused.");
+		}
+	}
+	File::remove(filename18);
+
+	std::cout << "Test 23 passed"
+			  << "\n";
+}
+
+void test24()
+{
+	//writing a page keeps its place in the page lists without reading it back, also after a reopen
+	const std::string &filename19 = "test.19";
+	const PageId filePages = 6;
+	try
+	{
+		File::remove(filename19);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file19 = File::create(filename19);
+		for (i = 0; i < filePages; i++)
+			file19.allocatePage();
+	}
+	{
+		File file19 = File::open(filename19);
+		std::vector<Page> copies;
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+			copies.push_back(file19.readPage(pageNo));
+		file19.deletePage(2);
+		file19.deletePage(4);
+
+		//the copies hold next page numbers from before the deletions, which the writes must not store
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo += 2)
+			file19.writePage(copies[pageNo - 1]);
+		std::vector<PageId> used;
+		for (FileIterator iter = file19.begin(); iter != file19.end(); ++iter)
+			used.push_back((*iter).page_number());
+		if (used.size() != 4 || used[0] != 1 || used[1] != 3 || used[2] != 5 || used[3] != 6)
+		{
+			PRINT_ERROR("ERROR :: Writing pages should not change the list of used pages.");
+		}
+
+		try
+		{
+			file19.writePage(copies[1]);
+			PRINT_ERROR("ERROR :: Writing a deleted page should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		if (file19.allocatePage().page_number() != 2 || file19.allocatePage().page_number() != 4)
+		{
+			PRINT_ERROR("ERROR :: The free pages should be intact.");
+		}
+	}
+	File::remove(filename19);
+
+	std::cout << "Test 24 passed"
+			  << "\n";
+}
+
+void test25()
+{
+	//allocated pages are linked into the used page list in page number order
+	const std::string &filename20 = "test.20";
+	const PageId filePages = 8;
+	const PageId freed[] = {1, 4, 8, 6};
+	try
+	{
+		File::remove(filename20);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file20 = File::create(filename20);
+		for (i = 0; i < filePages; i++)
+			file20.allocatePage();
+		for (i = 0; i < 4; i++)
+			file20.deletePage(freed[i]);
+	}
+	{
+		File file20 = File::open(filename20);
+		//the page directory hands out the lowest free page first, and then the file grows
+		const PageId reused[] = {1, 4, 6, 8};
+		if (file20.numUsedPages() != filePages - 4)
+		{
+			PRINT_ERROR("ERROR :: The file should count its used pages.");
+		}
+		for (i = 0; i < 4; i++)
+		{
+			if (file20.allocatePage().page_number() != reused[i])
+			{
+				PRINT_ERROR("ERROR :: Freed pages should be reused before the file grows.");
+			}
+		}
+		if (file20.allocatePage().page_number() != filePages + 1)
+		{
+			PRINT_ERROR("ERROR :: A full file should grow by one page.");
+		}
+		PageId expected = 1;
+		for (FileIterator iter = file20.begin(); iter != file20.end(); ++iter)
+		{
+			if ((*iter).page_number() != expected++)
+			{
+				PRINT_ERROR("ERROR :: The used pages should be listed in page number order.");
+			}
+		}
+		if (expected != filePages + 2)
+		{
+			PRINT_ERROR("ERROR :: Every allocated page should be in the list of used pages.");
+		}
+	}
+	File::remove(filename20);
+
+	std::cout << "Test 25 passed"
+			  << "\n";
+}
+
+void test26()
+{
+	//deleting the head, a middle page and the tail unlinks each from the used page list
+	const std::string &filename21 = "test.21";
+	const PageId filePages = 5;
+	try
+	{
+		File::remove(filename21);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file21 = File::create(filename21);
+		for (i = 0; i < filePages; i++)
+			file21.allocatePage();
+		file21.deletePage(1);
+		file21.deletePage(3);
+		file21.deletePage(5);
+		try
+		{
+			file21.deletePage(3);
+			PRINT_ERROR("ERROR :: Deleting a free page should fail. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+	}
+	{
+		File file21 = File::open(filename21);
+		std::vector<PageId> used;
+		for (FileIterator iter = file21.begin(); iter != file21.end(); ++iter)
+			used.push_back((*iter).page_number());
+		if (used.size() != 2 || used[0] != 2 || used[1] != 4)
+		{
+			PRINT_ERROR("ERROR :: Deleted pages should have left the list of used pages.");
+		}
+		file21.deletePage(2);
+		file21.deletePage(4);
+		if (file21.begin() != file21.end())
+		{
+			PRINT_ERROR("ERROR :: The list of used pages should be empty.");
+		}
+	}
+	File::remove(filename21);
+
+	std::cout << "Test 26 passed"
+			  << "\n";
+}
+
+void test27()
+{
+	//a file in the old page list format is upgraded to the page directory format when opened
+	const std::string &filename22 = "test.22";
+	const PageId filePages = 3;
+	std::vector<std::string> rawPages(filePages);
+	try
+	{
+		File::remove(filename22);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file22 = File::create(filename22);
+		for (i = 0; i < filePages; i++)
+		{
+			Page new_page = file22.allocatePage();
+			sprintf(tmpbuf, "legacy page %d", i + 1);
+			new_page.insertRecord(tmpbuf);
+			file22.writePage(new_page);
+		}
+		file22.deletePage(2);
+	}
+	{
+		//the first bitmap comes right after the header, so page n of the new format is at header + n pages
+		std::ifstream in(filename22.c_str(), std::ios::binary);
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+		{
+			rawPages[pageNo - 1].resize(Page::SIZE);
+			in.seekg(sizeof(FileHeader) + pageNo * Page::SIZE);
+			in.read(&rawPages[pageNo - 1][0], Page::SIZE);
+		}
+	}
+	File::remove(filename22);
+	{
+		//num_pages, first_used_page, num_free_pages and first_free_page, followed by the pages
+		const PageId legacyHeader[] = {filePages + 1, 1, 1, 2};
+		std::ofstream out(filename22.c_str(), std::ios::binary);
+		out.write(reinterpret_cast<const char *>(legacyHeader), sizeof(legacyHeader));
+		for (PageId pageNo = 1; pageNo <= filePages; pageNo++)
+			out.write(rawPages[pageNo - 1].data(), Page::SIZE);
+	}
+
+	{
+		File file22 = File::open(filename22);
+		if (file22.numUsedPages() != 2)
+		{
+			PRINT_ERROR("ERROR :: The upgraded file should count its used pages.");
+		}
+		std::vector<PageId> used;
+		for (FileIterator iter = file22.begin(); iter != file22.end(); ++iter)
+		{
+			Page page = *iter;
+			sprintf(tmpbuf, "legacy page %d", page.page_number());
+			if (strncmp((*page.begin()).c_str(), tmpbuf, strlen(tmpbuf)) != 0)
+			{
+				PRINT_ERROR("ERROR :: The upgraded file should keep the records of its pages.");
+			}
+			used.push_back(page.page_number());
+		}
+		if (used.size() != 2 || used[0] != 1 || used[1] != 3)
+		{
+			PRINT_ERROR("ERROR :: The upgraded file should keep its used pages.");
+		}
+		if (file22.allocatePage().page_number() != 2)
+		{
+			PRINT_ERROR("ERROR :: The upgraded file should reuse its free page.");
+		}
+	}
+	{
+		File file22 = File::open(filename22);
+		if (file22.numUsedPages() != filePages)
+		{
+			PRINT_ERROR("ERROR :: Reopening the upgraded file should keep its pages.");
+		}
+		std::uint32_t magic = 0;
+		std::ifstream in(filename22.c_str(), std::ios::binary);
+		in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+		if (magic != File::FORMAT_MAGIC || File::exists(filename22 + ".upgrade"))
+		{
+			PRINT_ERROR("ERROR :: The file should have been upgraded in place once.");
+		}
+	}
+	File::remove(filename22);
+
+	std::cout << "Test 27 passed"
+			  << "\n";
+}
+
+std::streamoff fileSize(const std::string &filename)
+{
+	std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+	return in.tellg();
+}
+
+void test28()
+{
+	//a growing file is extended a whole extent at a time, and the pages past the last one stay unallocated
+	const std::string &filename23 = "test.23";
+	const PageId extentPages = 16;
+	try
+	{
+		File::remove(filename23);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file23 = File::create(filename23);
+		file23.setExtentPages(extentPages);
+		for (i = 0; i < 3; i++)
+			file23.allocatePage();
+		//header, first bitmap and one extent of pages
+		if (fileSize(filename23) != std::streamoff(sizeof(FileHeader) + (extentPages + 1) * Page::SIZE))
+		{
+			PRINT_ERROR("ERROR :: The file should have grown by one extent.");
+		}
+	}
+	{
+		File file23 = File::open(filename23);
+		if (file23.extentPages() != File::DEFAULT_EXTENT_PAGES)
+		{
+			PRINT_ERROR("ERROR :: A file should be opened with the default extent size.");
+		}
+		try
+		{
+			file23.readPage(4);
+			PRINT_ERROR("ERROR :: Preallocated pages should not be readable. Exception should have been thrown before execution reaches this point.");
+		}
+		catch (InvalidPageException e)
+		{
+		}
+		file23.setExtentPages(extentPages);
+		for (i = 3; i < extentPages; i++)
+		{
+			if (file23.allocatePage().page_number() != PageId(i + 1))
+			{
+				PRINT_ERROR("ERROR :: Pages should be handed out from the preallocated extent in order.");
+			}
+		}
+		if (fileSize(filename23) != std::streamoff(sizeof(FileHeader) + (extentPages + 1) * Page::SIZE))
+		{
+			PRINT_ERROR("ERROR :: Filling the extent should not grow the file.");
+		}
+		file23.allocatePage();
+		if (fileSize(filename23) != std::streamoff(sizeof(FileHeader) + (2 * extentPages + 1) * Page::SIZE))
+		{
+			PRINT_ERROR("ERROR :: The file should have grown by a second extent.");
+		}
+
+		file23.setExtentPages(1);
+		file23.deletePage(1);
+		file23.allocatePage();
+		for (i = 0; i < extentPages; i++)
+			file23.allocatePage();
+		if (fileSize(filename23) != std::streamoff(sizeof(FileHeader) + (2 * extentPages + 2) * Page::SIZE))
+		{
+			PRINT_ERROR("ERROR :: Without an extent the file should grow one page at a time.");
+		}
+		if (file23.numUsedPages() != 2 * extentPages + 1)
+		{
+			PRINT_ERROR("ERROR :: Every allocated page should be used.");
+		}
+	}
+	File::remove(filename23);
+
+	std::cout << "Test 28 passed"
+			  << "\n";
+}
+
+void test29()
+{
+	//a run of pages across the first bitmap group boundary is written and read around the second bitmap
+	const std::string &filename24 = "test.24";
+	const PageId firstPage = File::PAGES_PER_BITMAP - 1;
+	const PageId runPages = 4;
+	try
+	{
+		File::remove(filename24);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file24 = File::create(filename24);
+		file24.setExtentPages(4096);
+		std::vector<Page> run;
+		for (PageId pageNo = 1; pageNo < firstPage + runPages; pageNo++)
+		{
+			Page new_page = file24.allocatePage();
+			if (pageNo >= firstPage)
+			{
+				sprintf(tmpbuf, "test.24 Page %u", pageNo);
+				new_page.insertRecord(tmpbuf);
+				run.push_back(new_page);
+			}
+		}
+		std::vector<const Page *> pages;
+		for (PageId j = 0; j < runPages; j++)
+			pages.push_back(&run[j]);
+		file24.writePages(pages);
+	}
+	{
+		File file24 = File::open(filename24);
+		std::vector<Page> run = file24.readPages(firstPage, runPages);
+		if (run.size() != runPages)
+		{
+			PRINT_ERROR("ERROR :: Every page of the run should have been read.");
+		}
+		for (PageId j = 0; j < run.size(); j++)
+		{
+			sprintf(tmpbuf, "test.24 Page %u", firstPage + j);
+			if (run[j].page_number() != firstPage + j || *run[j].begin() != tmpbuf)
+			{
+				PRINT_ERROR("ERROR :: A page of the run should have been read back as written.");
+			}
+		}
+		if (file24.numUsedPages() != firstPage + runPages - 1 ||
+			file24.allocatePage().page_number() != firstPage + runPages)
+		{
+			PRINT_ERROR("ERROR :: Writing the run should have left the second bitmap intact.");
+		}
+
+		BufMgr *mgr = new BufMgr(16);
+		std::vector<PageId> pageNos;
+		for (PageId j = 0; j < runPages; j++)
+			pageNos.push_back(firstPage + j);
+		std::vector<Page *> pinned;
+		mgr->readPages(&file24, pageNos, pinned);
+		for (PageId j = 0; j < runPages; j++)
+		{
+			sprintf(tmpbuf, "test.24 Page %u", firstPage + j);
+			if (pinned[j]->page_number() != firstPage + j || *pinned[j]->begin() != tmpbuf)
+			{
+				PRINT_ERROR("ERROR :: The buffer manager should have read the run as written.");
+			}
+			mgr->unPinPage(&file24, firstPage + j, false);
+		}
+		delete mgr;
+	}
+	File::remove(filename24);
+
+	std::cout << "Test 29 passed"
+			  << "\n";
+}
+
+void test30(ReplacementPolicyType policyType)
+{
+	//pages used repeatedly survive a scan in a pool large enough for the scan to be read ahead
+	const std::string &filename25 = "test.25";
+	const PageId poolSize = 64;
+	const PageId hotPages = 8;
+	const PageId coldPages = 400;
+	try
+	{
+		File::remove(filename25);
+	}
+	catch (FileNotFoundException e)
+	{
+	}
+
+	{
+		File file25 = File::create(filename25);
+		for (i = 0; i < (int)(hotPages + coldPages); i++)
+			file25.writePage(file25.allocatePage());
+
+		BufMgr *mgr = new BufMgr(poolSize, FLAT_HASH_TABLE, 1, policyType);
+		//touch the hot pages, let a few other pages push them out, and use them twice more
+		for (i = 1; i <= (int)(hotPages + poolSize); i++)
+		{
+			mgr->readPage(&file25, i, page);
+			mgr->unPinPage(&file25, i, false);
+		}
+		for (int round = 0; round < 2; round++)
+		{
+			for (i = 1; i <= (int)hotPages; i++)
+			{
+				mgr->readPage(&file25, i, page);
+				mgr->unPinPage(&file25, i, false);
+			}
+		}
+
+		//scan the rest of the file once, in order, so that it is read ahead
+		for (i = hotPages + poolSize + 1; i <= (int)(hotPages + coldPages); i++)
+		{
+			mgr->readPage(&file25, i, page);
+			mgr->unPinPage(&file25, i, false);
+		}
+		if (mgr->getBufStats().prefetched == 0)
+		{
+			PRINT_ERROR("ERROR :: The scan should have been read ahead.");
+		}
+
+		const int readsBefore = mgr->getBufStats().diskreads;
+		for (i = 1; i <= (int)hotPages; i++)
+		{
+			mgr->readPage(&file25, i, page);
+			mgr->unPinPage(&file25, i, false);
+		}
+		if (mgr->getBufStats().diskreads != readsBefore)
+		{
+			PRINT_ERROR("ERROR :: Hot pages should have stayed in the buffer pool during a scan read ahead.");
+		}
+
+		//scan again, first by prefetching each batch before reading it, then with readPages()
+		const PageId batch = 16;
+		const int prefetchedBefore = mgr->getBufStats().prefetched;
+		for (PageId first = hotPages + poolSize + 1; first <= hotPages + coldPages; first += batch)
+		{
+			std::vector<PageId> pageNos;
+			for (PageId pageNo = first; pageNo < first + batch && pageNo <= hotPages + coldPages; pageNo++)
+				pageNos.push_back(pageNo);
+			mgr->prefetch(&file25, pageNos);
+			for (size_t j = 0; j < pageNos.size(); j++)
+			{
+				mgr->readPage(&file25, pageNos[j], page);
+				mgr->unPinPage(&file25, pageNos[j], false);
+			}
+		}
+		if (mgr->getBufStats().prefetched == prefetchedBefore)
+		{
+			PRINT_ERROR("ERROR :: prefetch() should have read the scan ahead.");
+		}
+		for (PageId first = hotPages + poolSize + 1; first <= hotPages + coldPages; first += batch)
+		{
+			std::vector<PageId> pageNos;
+			std::vector<Page *> pages;
+			for (PageId pageNo = first; pageNo < first + batch && pageNo <= hotPages + coldPages; pageNo++)
+				pageNos.push_back(pageNo);
+			mgr->readPages(&file25, pageNos, pages);
+			for (size_t j = 0; j < pageNos.size(); j++)
+				mgr->unPinPage(&file25, pageNos[j], false);
+		}
+
+		const int readsAfterScans = mgr->getBufStats().diskreads;
+		for (i = 1; i <= (int)hotPages; i++)
+		{
+			mgr->readPage(&file25, i, page);
+			mgr->unPinPage(&file25, i, false);
+		}
+		if (mgr->getBufStats().diskreads != readsAfterScans)
+		{
+			PRINT_ERROR("ERROR :: Hot pages should have stayed in the buffer pool during scans by prefetch() and readPages().");
+		}
+		delete mgr;
+	}
+	File::remove(filename25);
+
+	std::cout << "Test 30 passed"
+			  << "\n";
+}
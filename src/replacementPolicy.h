@@ -0,0 +1,172 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "buffer.h"
+
+namespace badgerdb {
+
+/**
+* @brief Interface of the algorithms the buffer manager uses to choose which page to replace
+*
+* BufMgr tells the policy when a page is read into a frame, pinned again or
+* removed, and asks it for a victim when it needs a frame and none is free.
+* Policies may look at the pin count of a frame but must not rely on it
+* staying the same: a frame named as victim can be pinned by another thread
+* before BufMgr gets to it, in which case BufMgr asks again.
+*
+* Implementations are called concurrently from many threads.  pagePinned() is
+* called on every buffer hit, so it should not take a lock shared by the whole
+* pool; policies that keep ordered lists note the hit with noteHit() and
+* apply it under their latch when the frame comes up in pickVictim().
+*/
+class ReplacementPolicy
+{
+ public:
+	/**
+   * Destructor of ReplacementPolicy class
+	 */
+  virtual ~ReplacementPolicy() {}
+
+	/**
+   * A page was read into, or allocated in, a frame.  The frame is pinned.
+	 *
+	 * @param frame   	Frame holding the page
+	 * @param pageKey Identifies the page, for policies that remember pages after they are replaced
+	 */
+  virtual void pageLoaded(const FrameId frame, const std::uint64_t pageKey) = 0;
+
+	/**
+   * The page held by a frame was pinned again.
+	 *
+	 * @param frame   	Frame holding the page
+	 */
+  virtual void pagePinned(const FrameId frame) = 0;
+
+	/**
+   * The page held by a frame was replaced or dropped, and the frame is about to be cleared.
+	 *
+	 * @param frame   	Frame that held the page
+	 */
+  virtual void pageRemoved(const FrameId frame) = 0;
+
+	/**
+   * Chooses a frame whose page should be replaced.
+	 *
+	 * @param frame   	Frame reference, frame ID of the chosen frame returned via this variable
+	 * @return  			False if no frame holding an unpinned page was found
+	 */
+  virtual bool pickVictim(FrameId &frame) = 0;
+
+	/**
+   * Returns the frame the policy looks at next when it sweeps the pool, so
+   * the background writer can clean the frames ahead of it.
+	 *
+	 * @param frame   	Frame reference, frame ID of the next frame returned via this variable
+	 * @return  			False if the policy does not sweep the frames in order
+	 */
+  virtual bool sweepPosition(FrameId &frame) const
+  {
+		return false;
+  }
+
+	/**
+   * Returns true if the page held by the frame is unpinned and likely to be
+   * replaced soon, so writing it back ahead of time is worth it.
+	 *
+	 * @param frame   	Frame holding the page
+	 */
+  virtual bool likelyVictim(const FrameId frame) const
+  {
+		return isEvictable(frame);
+  }
+
+ protected:
+	/**
+   * Constructor of ReplacementPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  ReplacementPolicy(BufDesc *descs, const std::uint32_t bufs)
+		: bufDescTable(descs), numBufs(bufs), pendingHits(new std::atomic<std::uint64_t>[bufs])
+  {
+		for (std::uint32_t i = 0; i < bufs; i++)
+			pendingHits[i] = 0;
+  }
+
+	/**
+   * Notes a hit on the page held by the frame, to be applied later by
+   * takeHit().  Takes no lock; of several hits noted before they are taken,
+   * the last one is kept.
+	 *
+	 * @param frame   	Frame holding the page
+	 * @param stamp   	Nonzero value describing the hit, such as its logical time
+	 */
+  void noteHit(const FrameId frame, const std::uint64_t stamp)
+  {
+		pendingHits[frame].store(stamp, std::memory_order_relaxed);
+  }
+
+	/**
+   * Takes the hit last noted on the frame, if any.
+	 *
+	 * @param frame   	Frame holding the page
+	 * @return  			Stamp of the hit, or 0 if none was noted since the last call
+	 */
+  std::uint64_t takeHit(const FrameId frame)
+  {
+		if (pendingHits[frame].load(std::memory_order_relaxed) == 0)
+			return 0;
+		return pendingHits[frame].exchange(0, std::memory_order_relaxed);
+  }
+
+	/**
+   * Returns true if the frame holds a page that is not pinned at the moment.
+	 */
+  bool isEvictable(const FrameId frame) const
+  {
+		return bufDescTable[frame].valid && bufDescTable[frame].pinCnt == 0;
+  }
+
+	/**
+   * Returns true if the reference bit of the frame is set.
+	 */
+  bool isReferenced(const FrameId frame) const
+  {
+		return bufDescTable[frame].refbit;
+  }
+
+	/**
+   * Clears the reference bit of the frame, returning whether it was set.
+	 */
+  bool testAndClearRefbit(const FrameId frame)
+  {
+		return bufDescTable[frame].refbit.exchange(false);
+  }
+
+	/**
+   * Frame descriptors of the buffer pool
+	 */
+  BufDesc *bufDescTable;
+
+	/**
+   * Number of frames in the buffer pool
+	 */
+  std::uint32_t numBufs;
+
+ private:
+	/**
+   * Hit noted on each frame and not yet taken, 0 if there is none
+	 */
+  std::unique_ptr<std::atomic<std::uint64_t>[]> pendingHits;
+};
+
+}
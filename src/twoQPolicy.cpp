@@ -0,0 +1,104 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#include "twoQPolicy.h"
+
+namespace badgerdb {
+
+TwoQPolicy::TwoQPolicy(BufDesc *descs, const std::uint32_t bufs)
+	: ReplacementPolicy(descs, bufs),
+		kin(bufs / 4 > 0 ? bufs / 4 : 1),
+		kout(bufs / 2 > 0 ? bufs / 2 : 1),
+		frameQueue(bufs, NO_QUEUE),
+		framePosition(bufs),
+		frameKeys(bufs)
+{
+}
+
+bool TwoQPolicy::firstEvictable(std::list<FrameId> &queue, FrameId &frame)
+{
+	// hits move frames to the back of Am, so they are applied to the frames
+	// the scan comes across, which then come up again later on
+	for (std::list<FrameId>::iterator it = queue.begin(); it != queue.end(); ) {
+		const FrameId candidate = *it;
+		++it;
+		if (applyHit(candidate) && frameQueue[candidate] == AM_QUEUE)
+			continue;
+		if (isEvictable(candidate)) {
+			frame = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool TwoQPolicy::applyHit(const FrameId frame)
+{
+	if (takeHit(frame) == 0)
+		return false;
+	// accesses while in A1in are taken to be correlated and leave it in place
+	if (frameQueue[frame] == AM_QUEUE)
+		am.splice(am.end(), am, framePosition[frame]);
+	return true;
+}
+
+void TwoQPolicy::pageLoaded(const FrameId frame, const std::uint64_t pageKey)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	frameKeys[frame] = pageKey;
+	std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator>::iterator it = a1outIndex.find(pageKey);
+	if (it != a1outIndex.end()) {
+		// read again after it left A1in, so the page is hot
+		a1out.erase(it->second);
+		a1outIndex.erase(it);
+		frameQueue[frame] = AM_QUEUE;
+		framePosition[frame] = am.insert(am.end(), frame);
+	}
+	else {
+		frameQueue[frame] = A1IN_QUEUE;
+		framePosition[frame] = a1in.insert(a1in.end(), frame);
+	}
+}
+
+void TwoQPolicy::pagePinned(const FrameId frame)
+{
+	noteHit(frame, 1);
+}
+
+void TwoQPolicy::pageRemoved(const FrameId frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	takeHit(frame);
+	if (frameQueue[frame] == A1IN_QUEUE) {
+		a1in.erase(framePosition[frame]);
+		// remember the page, forgetting the oldest one if there are too many
+		const std::uint64_t key = frameKeys[frame];
+		if (a1outIndex.find(key) == a1outIndex.end()) {
+			a1outIndex[key] = a1out.insert(a1out.end(), key);
+			if (a1out.size() > kout) {
+				a1outIndex.erase(a1out.front());
+				a1out.pop_front();
+			}
+		}
+	}
+	else if (frameQueue[frame] == AM_QUEUE) {
+		am.erase(framePosition[frame]);
+	}
+	frameQueue[frame] = NO_QUEUE;
+}
+
+bool TwoQPolicy::pickVictim(FrameId &frame)
+{
+	std::lock_guard<std::mutex> guard(latch);
+	// replace from A1in while it holds more than its share, otherwise from Am;
+	// fall back to the other queue when every page in one is pinned
+	if (a1in.size() > kin && firstEvictable(a1in, frame))
+		return true;
+	return firstEvictable(am, frame) || firstEvictable(a1in, frame);
+}
+
+}
@@ -0,0 +1,123 @@
+/**
+ * @author See Contributors.txt for code contributors and overview of BadgerDB.
+ *
+ * @section LICENSE
+ * Copyright (c) 2012 Database Group, Computer Sciences Department, University of Wisconsin-Madison.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "replacementPolicy.h"
+
+namespace badgerdb {
+
+/**
+* @brief 2Q replacement (Johnson and Shasha), the full version with a ghost queue
+*
+* Pages read for the first time enter A1in, a FIFO holding about a quarter
+* of the pool.  When they leave it their keys are remembered in A1out for
+* about half a pool's worth of pages.  Pages read again while in A1out are
+* deemed hot and go to Am, an LRU list holding the rest of the pool.  Pages
+* touched only once, such as those of a scan, therefore never displace the
+* pages in Am.
+*/
+class TwoQPolicy : public ReplacementPolicy
+{
+ private:
+	/**
+   * Queue holding the page of a frame
+	 */
+  enum Queue {
+    NO_QUEUE,
+    A1IN_QUEUE,
+    AM_QUEUE
+  };
+
+	/**
+   * Protects all members below
+	 */
+  std::mutex latch;
+
+	/**
+   * Number of frames A1in is allowed to hold before it is replaced from first
+	 */
+  std::uint32_t kin;
+
+	/**
+   * Number of page keys A1out remembers
+	 */
+  std::uint32_t kout;
+
+	/**
+   * Frames whose pages were read once, oldest first
+	 */
+  std::list<FrameId> a1in;
+
+	/**
+   * Frames holding hot pages, least recently used first
+	 */
+  std::list<FrameId> am;
+
+	/**
+   * Keys of pages replaced from A1in, oldest first
+	 */
+  std::list<std::uint64_t> a1out;
+
+	/**
+   * Position of each key in A1out
+	 */
+  std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator> a1outIndex;
+
+	/**
+   * Queue holding the page of each frame
+	 */
+  std::vector<Queue> frameQueue;
+
+	/**
+   * Position of each frame in its queue
+	 */
+  std::vector<std::list<FrameId>::iterator> framePosition;
+
+	/**
+   * Key of the page held by each frame
+	 */
+  std::vector<std::uint64_t> frameKeys;
+
+	/**
+   * Returns the first frame in the list that holds an unpinned page.
+	 *
+	 * @return  			False if there is none
+	 */
+  bool firstEvictable(std::list<FrameId> &queue, FrameId &frame);
+
+	/**
+   * Applies the hit noted on the frame, if any, moving the frame to the back of Am if it is there.
+	 *
+	 * @return  			True if there was a hit
+	 */
+  bool applyHit(const FrameId frame);
+
+ public:
+	/**
+   * Constructor of TwoQPolicy class
+	 *
+	 * @param descs   Frame descriptors of the buffer pool
+	 * @param bufs   	Number of frames in the buffer pool
+	 */
+  TwoQPolicy(BufDesc *descs, const std::uint32_t bufs);
+
+  void pageLoaded(const FrameId frame, const std::uint64_t pageKey);
+
+  void pagePinned(const FrameId frame);
+
+  void pageRemoved(const FrameId frame);
+
+  bool pickVictim(FrameId &frame);
+};
+
+}